@@ -1,9 +1,16 @@
 from dotenv import load_dotenv
 import os
-from fastapi import FastAPI
+import asyncio
+from concurrent.futures import ThreadPoolExecutor
+from fastapi import FastAPI, Header, HTTPException, Response
 from fastapi.middleware.cors import CORSMiddleware
 from pydantic import BaseModel
-from wrapper import compute_SMA, compute_EMA, compute_RSI, compute_bollinger_bands, compute_MACD, compute_OBV
+import numpy as np
+from wrapper import compute_SMA, compute_EMA, compute_RSI, compute_bollinger_bands, compute_MACD, compute_OBV, compute_indicator_set, hash_series
+from binary_format import MEDIA_TYPES, binary_media_type, encode_arrays
+from result_cache import ResultCache
+from incremental import IncrementalResults, stream_key
+from utils.load_prices import PriceStore
 
 # load environment variables (API key)
 load_dotenv()
@@ -22,6 +29,54 @@ app.add_middleware(
     allow_headers=["*"],
 )
 
+# Indicator work runs on this pool rather than on the event loop. cffi releases the GIL for the
+# duration of every C call, so concurrent requests compute on separate cores; only request parsing
+# and the conversion of the result hold it. INDICATOR_WORKERS sets the pool size (default: CPUs)
+compute_pool = ThreadPoolExecutor(max_workers=int(os.getenv("INDICATOR_WORKERS", "0")) or os.cpu_count() or 1)
+
+def format_results(results, accept):
+    # JSON lists by default. When the Accept header names a binary media type the C output arrays are
+    # written straight into binary frames (see binary_format.py), skipping Python floats and pydantic
+    media_type = binary_media_type(accept)
+    if media_type is None:
+        return [result.tolist() for result in results]
+    return Response(content=encode_arrays(results, MEDIA_TYPES[media_type]), media_type=media_type)
+
+# Results of identical computations are served from an LRU cache, found by a hash of the inputs and
+# checked against a copy of them. INDICATOR_CACHE_ENTRIES and INDICATOR_CACHE_MB bound it; 0 entries
+# disables caching. The hash is seeded per process so its collisions cannot be precomputed
+result_cache = ResultCache(int(os.getenv("INDICATOR_CACHE_ENTRIES", "1024")),
+                           int(os.getenv("INDICATOR_CACHE_MB", "256")) * 1024 * 1024)
+CACHE_HASH_SEED = int.from_bytes(os.urandom(8), "little")
+
+def cached_results(name, series, params, compute):
+    # `series`: the contiguous float64 input arrays (or None), hashed in C; `params`: hashable
+    # parameters of the computation
+    key = (name, hash_series(*series, seed=CACHE_HASH_SEED), params)
+    return result_cache.get_or_compute(key, series, compute)
+
+async def run_indicator(accept, compute, series, *params):
+    def work():
+        arrays = [np.ascontiguousarray(values, dtype=np.double) for values in series]
+        results = cached_results(compute.__name__, arrays, params, lambda: [compute(*arrays, *params)])
+        formatted = format_results(results, accept)
+        return formatted[0] if isinstance(formatted, list) else formatted
+
+    loop = asyncio.get_running_loop()
+    try:
+        return await loop.run_in_executor(compute_pool, work)
+    except ValueError as error:
+        raise HTTPException(status_code=422, detail=str(error))
+
+# Price history loaded once at startup from PRICE_DATA_DIR (default: data/ at the repository root)
+DATA_DIR = os.getenv("PRICE_DATA_DIR", os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "data"))
+price_store = PriceStore()
+price_store.load_directory(DATA_DIR)
+
+# Full-history results over stored series are kept per (symbol, indicator) and extended as bars are
+# appended; INDICATOR_STREAMS bounds how many are kept
+incremental_results = IncrementalResults(int(os.getenv("INDICATOR_STREAMS", "256")))
+
 @app.get("/")
 def read_root():
     return {"Hello": "World"}
@@ -34,9 +89,8 @@ class GetSMA(BaseModel):
     window: int
 
 @app.post("/get_sma", response_model=list[float])
-def get_sma(request: GetSMA) -> list[float]: 
-    result = compute_SMA(request.prices, request.window)
-    return result.tolist()
+async def get_sma(request: GetSMA, accept: str | None = Header(default=None)) -> list[float]:
+    return await run_indicator(accept, compute_SMA, [request.prices], request.window)
 
 #------------------------------------------------
 # EMA Retrival 
@@ -46,9 +100,8 @@ class GetEMA(BaseModel):
     window: int
 
 @app.post("/get_ema", response_model=list[float])
-def get_ema(request: GetEMA) -> list[float]: 
-    result = compute_EMA(request.prices, request.window)
-    return result.tolist()
+async def get_ema(request: GetEMA, accept: str | None = Header(default=None)) -> list[float]:
+    return await run_indicator(accept, compute_EMA, [request.prices], request.window)
 
 #------------------------------------------------
 # RSI Retrival 
@@ -58,9 +111,8 @@ class GetRSI(BaseModel):
     window: int
 
 @app.post("/get_rsi", response_model=list[float])
-def get_rsi(request: GetRSI) -> list[float]: 
-    result = compute_RSI(request.prices, request.window)
-    return result.tolist()
+async def get_rsi(request: GetRSI, accept: str | None = Header(default=None)) -> list[float]:
+    return await run_indicator(accept, compute_RSI, [request.prices], request.window)
 
 #------------------------------------------------
 # Bollinger Bands Retrival
@@ -68,11 +120,11 @@ def get_rsi(request: GetRSI) -> list[float]:
 class GetBB(BaseModel):
     prices: list[float]
     window: int
+    std_devs: float = 2.0
 
-@app.post("/get_bollinger_bands", response_model=list[float])
-def get_bollinger_bands(request: GetBB) -> list[float]:
-    result = compute_bollinger_bands(request.prices, request.window)
-    return result.tolist()
+@app.post("/get_bollinger_bands", response_model=list[list[float]])
+async def get_bollinger_bands(request: GetBB, accept: str | None = Header(default=None)) -> list[list[float]]: # rows of [bottom, middle, top]
+    return await run_indicator(accept, compute_bollinger_bands, [request.prices], request.window, request.std_devs)
 
 #------------------------------------------------
 # MACD Retrival
@@ -80,10 +132,9 @@ def get_bollinger_bands(request: GetBB) -> list[float]:
 class GetMACD(BaseModel):
     prices: list[float]
 
-@app.post("/get_macd", response_model=list[float])
-def get_MACD(request: GetMACD)-> list[float]:
-    result = compute_MACD(request.prices)
-    return result.tolist()
+@app.post("/get_macd", response_model=list[list[float]])
+async def get_MACD(request: GetMACD, accept: str | None = Header(default=None)) -> list[list[float]]: # rows of [MACD, signal, histogram]
+    return await run_indicator(accept, compute_MACD, [request.prices])
 
 
 #------------------------------------------------
@@ -94,6 +145,125 @@ class GetOBV(BaseModel):
     volumes: list[float]
 
 @app.post("/get_obv", response_model=list[float])
-def get_OBV(request: GetOBV)-> list[float]:
-    result = compute_OBV(request.prices, request.volumes)
-    return result.tolist()
\ No newline at end of file
+async def get_OBV(request: GetOBV, accept: str | None = Header(default=None)) -> list[float]:
+    return await run_indicator(accept, compute_OBV, [request.prices, request.volumes])
+
+
+#------------------------------------------------
+# Several indicators over one series
+#------------------------------------------------
+class IndicatorRequest(BaseModel):
+    indicator: str # sma, ema, rsi, bollinger_bands, macd or obv
+    window: int = 0
+    std_devs: float = 2.0
+    fast_period: int = 12
+    slow_period: int = 26
+    signal_period: int = 9
+
+class GetIndicators(BaseModel):
+    prices: list[float]
+    volumes: list[float] | None = None # required for obv
+    indicators: list[IndicatorRequest]
+
+def cached_indicator_set(prices, indicators, volumes):
+    prices = np.ascontiguousarray(prices, dtype=np.double)
+    volumes = None if volumes is None else np.ascontiguousarray(volumes, dtype=np.double)
+    params = tuple(tuple(sorted(spec.items())) for spec in indicators)
+    return cached_results("indicator_set", [prices, volumes], params,
+                          lambda: compute_indicator_set(prices, indicators, volumes))
+
+def indicator_set_results(request: GetIndicators, accept):
+    results = cached_indicator_set(request.prices, [spec.model_dump() for spec in request.indicators], request.volumes)
+    return format_results(results, accept) # binary: one frame per indicator, in request order
+
+# one upload and one parse of the series for every indicator; each result has the same shape as
+# the matching single-indicator endpoint's response
+@app.post("/get_indicators")
+async def get_indicators(request: GetIndicators, accept: str | None = Header(default=None)) -> list:
+    loop = asyncio.get_running_loop()
+    try:
+        return await loop.run_in_executor(compute_pool, indicator_set_results, request, accept)
+    except ValueError as error:
+        raise HTTPException(status_code=422, detail=str(error))
+
+
+#------------------------------------------------
+# Indicators over stored series, referenced by symbol and date range
+#------------------------------------------------
+def stored_series(symbol: str):
+    try:
+        return price_store.get(symbol)
+    except KeyError:
+        raise HTTPException(status_code=404, detail=f"Unknown symbol: {symbol}")
+
+def stored_indicator_results(series, indicators, start, end, accept):
+    # the prices passed to C are views of the store's arrays; nothing is copied
+    first, last = series.index_range(start, end)
+    if first == 0 and all(stream_key(spec) is not None for spec in indicators):
+        # from the first bar: served from the incremental streams, which only compute appended bars
+        return format_results([incremental_results.results(series, spec, last) for spec in indicators], accept)
+    volumes = series.columns["volume"][first:last] if "volume" in series.columns else None
+    results = cached_indicator_set(series.columns["close"][first:last], indicators, volumes)
+    return format_results(results, accept)
+
+async def run_stored(series, indicators, start, end, accept):
+    loop = asyncio.get_running_loop()
+    try:
+        return await loop.run_in_executor(compute_pool, stored_indicator_results, series, indicators, start, end, accept)
+    except ValueError as error:
+        raise HTTPException(status_code=422, detail=str(error))
+
+@app.get("/symbols")
+def list_symbols() -> list[str]:
+    return price_store.symbols()
+
+class AppendBars(BaseModel):
+    timestamps: list[str] # ISO dates or timestamps, ascending and after the symbol's last bar
+    open: list[float] | None = None # each field the stored series has is required
+    high: list[float] | None = None
+    low: list[float] | None = None
+    close: list[float] | None = None
+    volume: list[float] | None = None
+
+# appends new bars (e.g. the nightly or an intraday bar); later requests from the first bar only
+# compute the indicators over the appended bars
+@app.post("/symbols/{symbol}/bars")
+def append_bars(symbol: str, request: AppendBars) -> dict:
+    columns = {name: values for name, values in request.model_dump(exclude={"timestamps"}).items() if values is not None}
+    try:
+        series = price_store.append(symbol, request.timestamps, columns)
+    except KeyError:
+        raise HTTPException(status_code=404, detail=f"Unknown symbol: {symbol}")
+    except ValueError as error:
+        raise HTTPException(status_code=422, detail=str(error))
+    return {"symbol": series.symbol, "bars": len(series), "last": str(series.timestamps[-1]) if len(series) else None}
+
+# e.g. GET /symbols/AAPL/rsi?window=14&start=2024-01-01 -- same response as /get_rsi
+@app.get("/symbols/{symbol}/{indicator}")
+async def get_symbol_indicator(symbol: str, indicator: str, window: int = 0, std_devs: float = 2.0,
+                               fast_period: int = 12, slow_period: int = 26, signal_period: int = 9,
+                               start: str | None = None, end: str | None = None,
+                               accept: str | None = Header(default=None)):
+    spec = IndicatorRequest(indicator=indicator, window=window, std_devs=std_devs, fast_period=fast_period,
+                            slow_period=slow_period, signal_period=signal_period)
+    result = await run_stored(stored_series(symbol), [spec.model_dump()], start, end, accept)
+    return result[0] if isinstance(result, list) else result
+
+class GetSymbolIndicators(BaseModel):
+    indicators: list[IndicatorRequest]
+    start: str | None = None # inclusive ISO dates or timestamps
+    end: str | None = None
+
+# several indicators over one stored series, as /get_indicators
+@app.post("/symbols/{symbol}/indicators")
+async def get_symbol_indicators(symbol: str, request: GetSymbolIndicators, accept: str | None = Header(default=None)) -> list:
+    return await run_stored(stored_series(symbol), [spec.model_dump() for spec in request.indicators],
+                            request.start, request.end, accept)
+
+
+#------------------------------------------------
+# Result cache counters
+#------------------------------------------------
+@app.get("/cache_stats")
+def cache_stats() -> dict:
+    return result_cache.stats()
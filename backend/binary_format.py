@@ -0,0 +1,63 @@
+# Compact binary encoding of indicator results, used instead of JSON when the client asks for it with
+# an Accept header. Each array is one frame: a 16-byte little-endian header followed by the raw values
+#
+#   offset  size  field
+#   0       4     magic b"IND1"
+#   4       1     dtype: b"d" float64, b"f" float32
+#   5       1     ndim (1 or 2)
+#   6       2     reserved, zero
+#   8       4     rows (uint32)
+#   12      4     columns (uint32; 1 for 1-D arrays)
+#   16      ...   rows * columns values, row-major, little-endian
+#
+# A response holds one frame per result (several for /get_indicators), back to back
+import struct
+import numpy as np
+
+MAGIC = b"IND1"
+HEADER = struct.Struct("<4s1sBxxII")
+
+# Accept media type -> numpy dtype of the values
+MEDIA_TYPES = {
+    "application/vnd.indicators.f64": np.dtype("<f8"),
+    "application/vnd.indicators.f32": np.dtype("<f4"),
+    "application/octet-stream": np.dtype("<f8"),
+}
+
+def binary_media_type(accept):
+    # first binary media type listed in an Accept header, or None to respond with JSON
+    for part in (accept or "").split(","):
+        media_type = part.split(";")[0].strip().lower()
+        if media_type in MEDIA_TYPES:
+            return media_type
+    return None
+
+def encode_array(values, dtype):
+    # one frame; the values are copied once, straight from the array's buffer
+    values = np.asarray(values)
+    if values.ndim not in (1, 2):
+        raise ValueError("Only 1-D and 2-D results can be encoded")
+    rows = values.shape[0]
+    columns = values.shape[1] if values.ndim == 2 else 1
+    data = np.ascontiguousarray(values, dtype=dtype)
+    code = b"d" if dtype.itemsize == 8 else b"f"
+    return HEADER.pack(MAGIC, code, values.ndim, rows, columns) + data.tobytes()
+
+def encode_arrays(arrays, dtype):
+    return b"".join(encode_array(values, dtype) for values in arrays)
+
+def decode_arrays(payload):
+    # inverse of encode_arrays, for clients and tests; the arrays are read-only views of `payload`
+    arrays = []
+    offset = 0
+    while offset < len(payload):
+        magic, code, ndim, rows, columns = HEADER.unpack_from(payload, offset)
+        if magic != MAGIC:
+            raise ValueError("Not an indicator frame")
+        offset += HEADER.size
+        dtype = np.dtype("<f8") if code == b"d" else np.dtype("<f4")
+        count = rows * columns
+        values = np.frombuffer(payload, dtype=dtype, count=count, offset=offset)
+        arrays.append(values.reshape(rows, columns) if ndim == 2 else values)
+        offset += count * dtype.itemsize
+    return arrays
@@ -0,0 +1,38 @@
+# Builds `_indicators`, a cffi API-mode extension module compiled from the C engine sources.
+# Run `make python` in c_engine (or `python3 build_indicators.py`); the module is written next to
+# wrapper.py, which imports it in place of loading indicators.so through libffi
+import glob
+import os
+import shutil
+import sys
+from cffi import FFI
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+ENGINE_DIR = os.path.normpath(os.path.join(HERE, "..", "c_engine"))
+
+sys.path.insert(0, HERE)
+from indicators_cdef import CDEF
+
+ffibuilder = FFI()
+ffibuilder.cdef(CDEF)
+ffibuilder.set_source(
+    "_indicators",
+    """
+    #include "indicators.h"
+    #include "panel.h"
+    #include "threadpool.h"
+    #include "price_file.h"
+    #include "csv_parser.h"
+    #include "series_hash.h"
+    """,
+    sources=sorted(glob.glob(os.path.join(ENGINE_DIR, "*.c"))),
+    include_dirs=[ENGINE_DIR],
+    extra_compile_args=["-O2", "-ffp-contract=off", "-pthread"], # same numerics as the Makefile build
+    extra_link_args=["-pthread"],
+    libraries=["m"],
+)
+
+if __name__ == "__main__":
+    module = ffibuilder.compile(tmpdir=os.path.join(HERE, "build"), verbose=True)
+    shutil.copy(module, HERE)
+    print(f"Built {os.path.join(HERE, os.path.basename(module))}")
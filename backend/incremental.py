@@ -0,0 +1,87 @@
+# Indicator results over stored series that are extended, not recomputed, when bars are appended.
+#
+# Each (symbol, indicator, parameters) gets a tracker holding a wrapper.IndicatorStream and the outputs
+# produced so far. A request first feeds the tracker any bars appended since its last use, so
+# a nightly or intraday update costs O(new bars) instead of O(history). Results for a prefix of the
+# series (an `end` bound) are a prefix of the outputs, since every indicator only looks backwards.
+#
+# Trackers follow a series' lineage (see PriceSeries.appended): when a symbol is reloaded from disk
+# its tracker is rebuilt from the new history. The number of trackers is bounded; the least recently
+# used are dropped first.
+import threading
+from collections import OrderedDict
+import numpy as np
+from wrapper import STREAM_INDICATORS, IndicatorStream
+
+MIN_OUTPUT_CAPACITY = 256
+
+def stream_key(spec):
+    # the parameters that affect the indicator's values; None if it has no streaming form
+    indicator = spec["indicator"]
+    if indicator not in STREAM_INDICATORS:
+        return None
+    if indicator == "macd":
+        return (indicator, spec["fast_period"], spec["slow_period"], spec["signal_period"])
+    if indicator == "obv":
+        return (indicator,)
+    return (indicator, spec["window"])
+
+class _Tracker:
+    def __init__(self, spec, lineage):
+        self.stream = IndicatorStream(spec["indicator"], window=spec["window"], fast_period=spec["fast_period"],
+                                      slow_period=spec["slow_period"], signal_period=spec["signal_period"])
+        self.lineage = lineage
+        self.bars = 0         # bars of the series consumed by the stream
+        self.outputs = None   # output rows, with spare capacity
+        self.rows = 0
+        self.lock = threading.Lock()
+
+    def catch_up(self, series):
+        prices = series.columns["close"][self.bars:]
+        volumes = None
+        if self.stream.indicator == "obv":
+            if "volume" not in series.columns:
+                raise ValueError("OBV needs volumes")
+            volumes = series.columns["volume"][self.bars:]
+        new_rows = self.stream.extend(prices, volumes)
+
+        needed = self.rows + len(new_rows)
+        if self.outputs is None or len(self.outputs) < needed:
+            grown = np.empty((max(2 * needed, MIN_OUTPUT_CAPACITY),) + new_rows.shape[1:], dtype=np.double)
+            if self.outputs is not None:
+                grown[:self.rows] = self.outputs[:self.rows]
+            self.outputs = grown
+        self.outputs[self.rows:needed] = new_rows
+        self.rows = needed
+        self.bars = len(series)
+
+class IncrementalResults:
+    def __init__(self, max_trackers):
+        self.max_trackers = max_trackers
+        self._trackers = OrderedDict() # (symbol, stream_key) -> _Tracker, least recently used first
+        self._lock = threading.Lock()
+
+    def _tracker(self, series, spec):
+        key = (series.symbol, stream_key(spec))
+        with self._lock:
+            tracker = self._trackers.get(key)
+            if tracker is None or tracker.lineage is not series.lineage or tracker.bars > len(series):
+                tracker = _Tracker(spec, series.lineage)
+                self._trackers[key] = tracker
+            self._trackers.move_to_end(key)
+            while len(self._trackers) > self.max_trackers:
+                self._trackers.popitem(last=False)
+        return tracker
+
+    def results(self, series, spec, last):
+        # the indicator over bars [0, last) of `series`, shaped like the matching compute_* result
+        tracker = self._tracker(series, spec)
+        with tracker.lock:
+            if tracker.bars < len(series):
+                tracker.catch_up(series)
+            count = tracker.stream.output_length(last)
+            if count <= 0:
+                raise ValueError("Not enough prices for the indicator")
+            result = tracker.outputs[:count] # later appends only write past these rows
+        result.flags.writeable = False
+        return result
@@ -0,0 +1,174 @@
+# C declarations of the indicator engine shared by wrapper.py (ABI mode) and build_indicators.py
+# (API mode). Keep in sync with the headers in c_engine/
+CDEF = """
+void c_free(void *ptr);
+typedef enum
+{
+    INDICATOR_SMA,
+    INDICATOR_EMA,
+    INDICATOR_RSI,
+    INDICATOR_BOLLINGER,
+    INDICATOR_MACD,
+    INDICATOR_OBV
+} IndicatorType;
+int compute_output_length(IndicatorType type, int length, int window);
+typedef enum
+{
+    SIMD_SCALAR,
+    SIMD_AVX2,
+    SIMD_AVX512
+} SimdLevel;
+int get_simd_level(void);
+int set_simd_level(int level);
+int set_rolling_simd(int enabled);
+int get_rolling_simd(void);
+double *compute_SMA(double *prices, int length, int window);
+int compute_SMA_into(const double *prices, int length, int window, double *SMA_Values);
+double *compute_EMA(double *prices, int length, int window);
+int compute_EMA_into(const double *prices, int length, int window, double *EMA_Values);
+double *compute_RSI(double *prices, int length, int window);
+int compute_RSI_into(const double *prices, int length, int window, double *RSI_Values);
+int compute_std_devs(double *prices, int length, int window, double *means, double *std_devs);
+typedef struct
+{
+    double *middle_band;
+    double *top_band;
+    double *bottom_band;
+    int length;
+} BollingerBands;
+void cleanup_bands(BollingerBands *band_values);
+BollingerBands *compute_bollinger_bands(double *prices, int length, int window, double std_devs);
+int compute_bollinger_bands_into(const double *prices, int length, int window, double std_devs,
+                                 double *middle_band, double *top_band, double *bottom_band);
+#define MACD_FAST_PERIOD 12
+#define MACD_SLOW_PERIOD 26
+#define MACD_SIGNAL_PERIOD 9
+typedef struct
+{
+    int length;
+    double *MACD_Values;
+    double *signal_line_Values;
+    double *histogram_Values;
+} MACD;
+int cleanup_MACD(MACD *macd);
+MACD *compute_MACD(double *prices, int length);
+MACD *compute_MACD_periods(double *prices, int length, int fast_period, int slow_period, int signal_period);
+int compute_MACD_into(const double *prices, int length, double *MACD_Values, double *signal_line_Values);
+int compute_MACD_periods_into(const double *prices, int length, int fast_period, int slow_period, int signal_period,
+                              double *MACD_Values, double *signal_line_Values, double *histogram_Values);
+double *compute_OBV(const double *prices, const double *volumes, int length);
+int compute_OBV_into(const double *prices, const double *volumes, int length, double *OBV_values);
+int compute_RSI_OBV_into(const double *prices, const double *volumes, int length, int window,
+                         double *RSI_Values, double *OBV_values);
+typedef struct
+{
+    IndicatorType type;
+    int window;
+    double std_devs;
+    int fast_period;
+    int slow_period;
+    int signal_period;
+} IndicatorSpec;
+typedef enum
+{
+    PANEL_ROW_MAJOR,
+    PANEL_COLUMN_MAJOR
+} PanelLayout;
+typedef struct
+{
+    const double *prices;
+    const double *volumes;
+    const int *lengths;
+    int symbols;
+    int time_steps;
+    PanelLayout layout;
+} PricePanel;
+int indicator_output_planes(IndicatorType type);
+int indicator_lead(const IndicatorSpec *spec);
+int compute_indicator_set(const IndicatorSpec *specs, int spec_count, const double *prices,
+                          const double *volumes, int length, double **outs);
+int compute_panel(const PricePanel *panel, const IndicatorSpec *spec, double *out);
+int compute_EMA_interleaved(const double *prices, size_t stride, int symbols, int length, int window,
+                            double *EMA_Values);
+int compute_RSI_interleaved(const double *prices, size_t stride, int symbols, int length, int window,
+                            double *RSI_Values);
+int compute_MACD_interleaved(const double *prices, size_t stride, int symbols, int length,
+                             int fast_period, int slow_period, int signal_period,
+                             double *MACD_Values, double *signal_line_Values, double *histogram_Values);
+typedef struct ThreadPool ThreadPool;
+ThreadPool *init_thread_pool(int threads);
+int thread_pool_size(const ThreadPool *pool);
+void cleanup_thread_pool(ThreadPool *pool);
+int compute_panel_parallel(ThreadPool *pool, const PricePanel *panel, const IndicatorSpec *specs,
+                           int spec_count, double **outs);
+typedef struct
+{
+    int rows;
+    char symbol[17];
+    const int64_t *timestamps;
+    const double *open;
+    const double *high;
+    const double *low;
+    const double *close;
+    const double *volume;
+    void *mapping;
+    size_t mapping_size;
+} PriceFile;
+PriceFile *open_price_file(const char *path);
+void close_price_file(PriceFile *file);
+int price_file_range(const PriceFile *file, int64_t start, int64_t end, int *first);
+int write_price_file(const char *path, const char *symbol, int rows, const int64_t *timestamps,
+                     const double *open, const double *high, const double *low,
+                     const double *close, const double *volume);
+
+typedef struct
+{
+    int rows;
+    unsigned fields;
+    int64_t *timestamps;
+    double *open;
+    double *high;
+    double *low;
+    double *close;
+    double *volume;
+} PriceColumns;
+PriceColumns *parse_price_csv_buffer(const char *data, size_t size, ThreadPool *pool);
+PriceColumns *parse_price_csv(const char *path, ThreadPool *pool);
+void free_price_columns(PriceColumns *columns);
+
+uint64_t hash_series(const double *values, int length, uint64_t seed);
+
+typedef struct SMAStream SMAStream;
+typedef struct EMAStream EMAStream;
+typedef struct RSIStream RSIStream;
+typedef struct MACDStream MACDStream;
+typedef struct OBVStream OBVStream;
+typedef struct
+{
+    double MACD_Value;
+    double signal_line_Value;
+    double histogram_Value;
+} MACDPoint;
+SMAStream *init_SMA_stream(const double *history, int length, int window);
+double get_SMA_stream_value(const SMAStream *stream);
+int append_SMA_stream(SMAStream *stream, const double *prices, int count, double *SMA_Values);
+void cleanup_SMA_stream(SMAStream *stream);
+EMAStream *init_EMA_stream(const double *history, int length, int window);
+double get_EMA_stream_value(const EMAStream *stream);
+int append_EMA_stream(EMAStream *stream, const double *prices, int count, double *EMA_Values);
+void cleanup_EMA_stream(EMAStream *stream);
+RSIStream *init_RSI_stream(const double *history, int length, int window);
+double get_RSI_stream_value(const RSIStream *stream);
+int append_RSI_stream(RSIStream *stream, const double *prices, int count, double *RSI_Values);
+void cleanup_RSI_stream(RSIStream *stream);
+MACDStream *init_MACD_stream(const double *history, int length, int fast_period, int slow_period, int signal_period);
+int get_MACD_stream_point(const MACDStream *stream, MACDPoint *point);
+int append_MACD_stream(MACDStream *stream, const double *prices, int count, double *MACD_Values,
+                       double *signal_line_Values, double *histogram_Values);
+void cleanup_MACD_stream(MACDStream *stream);
+OBVStream *init_OBV_stream(const double *prices, const double *volumes, int length);
+double get_OBV_stream_value(const OBVStream *stream);
+int append_OBV_stream(OBVStream *stream, const double *prices, const double *volumes, int count,
+                      double *OBV_values);
+void cleanup_OBV_stream(OBVStream *stream);
+"""
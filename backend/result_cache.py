@@ -0,0 +1,81 @@
+# Bounded LRU cache of indicator results, so repeated chart loads of the same series and parameters
+# cost a hash and a lookup instead of a compute.
+#
+# Keys combine the computation's name and parameters with wrapper.hash_series() of its input arrays,
+# so identical inputs hit no matter which endpoint or symbol they came from and no invalidation is
+# needed when stored series are reloaded. The hash only locates an entry: each entry keeps a copy of
+# its inputs, and a hit is served only when they are bit for bit the caller's, so a hash collision
+# (accidental or crafted) costs a recompute, never another input's results. The cache is bounded by
+# entry count and by the bytes of the cached inputs and results, evicting the least recently used
+# entries first. Cached arrays are marked read-only because every hit returns the same objects.
+import threading
+from collections import OrderedDict
+import numpy as np
+
+def _same_inputs(stored, inputs):
+    # bitwise equality, as hash_series sees the values: NaN payloads and the sign of zero count
+    if len(stored) != len(inputs):
+        return False
+    for a, b in zip(stored, inputs):
+        if a is None or b is None:
+            if a is not b:
+                return False
+        elif a.shape != b.shape or not np.array_equal(a.view(np.uint64), b.view(np.uint64)):
+            return False
+    return True
+
+class ResultCache:
+    def __init__(self, max_entries, max_bytes):
+        self.max_entries = max_entries
+        self.max_bytes = max_bytes
+        self._entries = OrderedDict() # key -> (inputs, results, bytes), least recently used first
+        self._bytes = 0
+        self._lock = threading.Lock()
+        self.hits = 0
+        self.misses = 0
+        self.evictions = 0
+
+    def get_or_compute(self, key, inputs, compute):
+        # `inputs`: the contiguous float64 arrays (or None) the results are computed from, compared on
+        # every hit; `compute()` returns a list of arrays. Concurrent misses on one key may both
+        # compute; the last one stored wins
+        with self._lock:
+            entry = self._entries.get(key)
+            if entry is not None and _same_inputs(entry[0], inputs):
+                self._entries.move_to_end(key)
+                self.hits += 1
+                return entry[1]
+            self.misses += 1
+
+        results = compute()
+        if self.max_entries <= 0:
+            return results
+        size = sum(result.nbytes for result in results) + sum(values.nbytes for values in inputs if values is not None)
+        if size > self.max_bytes:
+            return results
+        inputs = [None if values is None else values.copy() for values in inputs] # callers may reuse theirs
+        for result in results:
+            result.flags.writeable = False
+
+        with self._lock:
+            previous = self._entries.pop(key, None)
+            if previous is not None:
+                self._bytes -= previous[2]
+            self._entries[key] = (inputs, results, size)
+            self._bytes += size
+            while len(self._entries) > self.max_entries or self._bytes > self.max_bytes:
+                _, (_, _, evicted_size) = self._entries.popitem(last=False)
+                self._bytes -= evicted_size
+                self.evictions += 1
+        return results
+
+    def stats(self):
+        with self._lock:
+            return {"hits": self.hits, "misses": self.misses, "evictions": self.evictions,
+                    "entries": len(self._entries), "bytes": self._bytes,
+                    "max_entries": self.max_entries, "max_bytes": self.max_bytes}
+
+    def clear(self):
+        with self._lock:
+            self._entries.clear()
+            self._bytes = 0
@@ -0,0 +1,95 @@
+# Compares CSV loading: the C parser (wrapper.parse_price_csv) against the csv module and, when it is
+# installed, pandas.read_csv. Without a path a synthetic Alpha Vantage style file is generated.
+#
+#   python3 utils/bench_csv_loading.py                  # 1,000,000 generated rows
+#   python3 utils/bench_csv_loading.py --rows 200000
+#   python3 utils/bench_csv_loading.py ../data/AAPL.csv
+import argparse
+import csv
+import os
+import sys
+import tempfile
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+from wrapper import PRICE_FILE_FIELDS, parse_price_csv
+
+import numpy as np
+
+def write_sample(path, rows):
+    # newest bar first, as vendors deliver it
+    days = np.datetime64("1990-01-01") + np.arange(rows)[::-1]
+    close = 100.0 + 40.0 * np.sin(np.arange(rows)[::-1] * 0.01)
+    with open(path, "w") as f:
+        f.write("timestamp,open,high,low,close,volume\n")
+        for day, c, v in zip(days.astype(str), close, range(rows)):
+            f.write(f"{day},{c - 0.37:.4f},{c + 1.21:.4f},{c - 1.08:.4f},{c:.4f},{1000000 + v}\n")
+
+def load_with_csv_module(path):
+    with open(path, newline="") as f:
+        reader = csv.reader(f)
+        header = [name.strip().lower() for name in next(reader)]
+        time_column = header.index("timestamp")
+        field_columns = {name: header.index(name) for name in PRICE_FILE_FIELDS if name in header}
+        timestamps = []
+        values = {name: [] for name in field_columns}
+        for row in reader:
+            if not row:
+                continue
+            timestamps.append(row[time_column].strip())
+            for name, column in field_columns.items():
+                values[name].append(row[column])
+    timestamps = np.array(timestamps, dtype="datetime64[s]")
+    order = np.argsort(timestamps, kind="stable")
+    return timestamps[order], {name: np.array(column, dtype=np.double)[order] for name, column in values.items()}
+
+def load_with_pandas(path):
+    import pandas
+    frame = pandas.read_csv(path, parse_dates=["timestamp"]).sort_values("timestamp", kind="stable")
+    timestamps = frame["timestamp"].to_numpy().astype("datetime64[s]")
+    return timestamps, {name: frame[name].to_numpy(dtype=np.double) for name in PRICE_FILE_FIELDS if name in frame}
+
+def best_time(load, path, repeats):
+    best = float("inf")
+    for _ in range(repeats):
+        start = time.perf_counter()
+        result = load(path)
+        best = min(best, time.perf_counter() - start)
+    return best, result
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("path", nargs="?")
+    parser.add_argument("--rows", type=int, default=1_000_000)
+    parser.add_argument("--repeats", type=int, default=3)
+    args = parser.parse_args()
+
+    path = args.path
+    if path is None:
+        handle, path = tempfile.mkstemp(suffix=".csv")
+        os.close(handle)
+        write_sample(path, args.rows)
+    try:
+        megabytes = os.path.getsize(path) / 1e6
+        loaders = [("C parser", parse_price_csv), ("csv module", load_with_csv_module)]
+        try:
+            import pandas # noqa: F401
+            loaders.append(("pandas", load_with_pandas))
+        except ImportError:
+            print("pandas is not installed; skipping it")
+
+        reference = None
+        for name, load in loaders:
+            seconds, (timestamps, columns) = best_time(load, path, args.repeats)
+            if reference is None:
+                reference = (timestamps, columns)
+            elif not (np.array_equal(timestamps, reference[0]) and
+                      all(np.array_equal(columns[k], reference[1][k], equal_nan=True) for k in reference[1])):
+                print(f"{name}: results differ from the C parser")
+            print(f"{name:>10}: {len(timestamps)} rows in {seconds * 1e3:8.1f} ms ({megabytes / seconds:7.1f} MB/s)")
+    finally:
+        if args.path is None:
+            os.remove(path)
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,38 @@
+# Converts CSV price history into columnar binary price files (see c_engine/price_file.h), which the
+# price store maps at startup instead of parsing text.
+#
+#   python3 utils/convert_prices.py ../data            # every data/*.csv -> data/<SYMBOL>.prices
+#   python3 utils/convert_prices.py ../data/AAPL.csv   # one file
+import os
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+from wrapper import PRICE_FILE_FIELDS, write_price_file
+from utils.load_prices import load_csv
+
+import numpy as np
+
+def convert(csv_path):
+    series = load_csv(csv_path)
+    # fields missing from the CSV are stored as NaN so every file has the same columns
+    columns = {name: series.columns.get(name, np.full(len(series), np.nan)) for name in PRICE_FILE_FIELDS}
+    out_path = os.path.join(os.path.dirname(csv_path), series.symbol + ".prices")
+    write_price_file(out_path, series.symbol, series.timestamps, columns)
+    return out_path, len(series)
+
+def main(paths):
+    csv_paths = []
+    for path in paths:
+        if os.path.isdir(path):
+            csv_paths += [os.path.join(path, name) for name in sorted(os.listdir(path)) if name.lower().endswith(".csv")]
+        else:
+            csv_paths.append(path)
+
+    for csv_path in csv_paths:
+        out_path, rows = convert(csv_path)
+        print(f"{csv_path} -> {out_path} ({rows} rows)")
+
+if __name__ == "__main__":
+    if len(sys.argv) < 2:
+        sys.exit("usage: convert_prices.py CSV_FILE_OR_DIRECTORY ...")
+    main(sys.argv[1:])
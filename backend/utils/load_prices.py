@@ -1 +1,150 @@
-# fetch data via API, Alpha Vantage
+# Loads daily price history from data/ into memory so endpoints can reference series by symbol
+# instead of receiving the prices in every request. <SYMBOL>.prices files (columnar binary, written by
+# utils/convert_prices.py) are memory-mapped by the C engine without parsing; <SYMBOL>.csv files are
+# parsed and used for symbols that have no .prices file.
+#
+# CSV files use the Alpha Vantage TIME_SERIES_DAILY layout: a header row naming the columns
+# (timestamp, open, high, low, close, volume; extra columns are ignored) and one row per bar in any
+# order. Rows are sorted by time on load.
+import os
+import threading
+import numpy as np
+
+MIN_APPEND_CAPACITY = 256
+
+class _GrowableColumns:
+    # storage behind series that have been appended to: arrays with spare capacity, doubled when full.
+    # Every PriceSeries on it views a prefix and appends only write past `length`, so earlier
+    # snapshots stay valid while new bars arrive
+    def __init__(self, timestamps, columns, capacity):
+        length = len(timestamps)
+        self.timestamps = np.empty(capacity, dtype="datetime64[s]")
+        self.timestamps[:length] = timestamps
+        self.columns = {}
+        for name, values in columns.items():
+            self.columns[name] = np.empty(capacity, dtype=np.double)
+            self.columns[name][:length] = values
+        self.length = length
+
+    def capacity(self):
+        return len(self.timestamps)
+
+class PriceSeries:
+    # one symbol's bars as contiguous columns: `timestamps` (datetime64[s]) and one float64 array per
+    # field, oldest first. Slices returned by `select` are views, so the C engine reads this memory directly.
+    # `lineage` is shared by a series and the series appended from it, whose first bars are the same
+    def __init__(self, symbol, timestamps, columns, storage=None, lineage=None):
+        self.symbol = symbol
+        self.timestamps = timestamps
+        self.columns = columns
+        self._storage = storage
+        self.lineage = lineage if lineage is not None else object()
+
+    def __len__(self):
+        return len(self.timestamps)
+
+    def index_range(self, start=None, end=None):
+        # [first, last) bar indices with start <= timestamp <= end; either bound may be None
+        first = 0 if start is None else int(np.searchsorted(self.timestamps, np.datetime64(start, "s"), side="left"))
+        last = len(self) if end is None else int(np.searchsorted(self.timestamps, _end_of(end), side="right"))
+        return first, max(first, last)
+
+    def select(self, field="close", start=None, end=None):
+        if field not in self.columns:
+            raise ValueError(f"Unknown price field: {field}")
+        first, last = self.index_range(start, end)
+        return self.columns[field][first:last]
+
+    def appended(self, timestamps, columns):
+        # a new series with the given bars after this one's. The bars must be later than the last one
+        # and give every field of the series. Amortized O(new bars): the storage grows by doubling
+        # and is shared with this series
+        timestamps = np.asarray(timestamps, dtype="datetime64[s]")
+        count = len(timestamps)
+        if set(columns) != set(self.columns):
+            raise ValueError(f"Appended bars should have the fields {sorted(self.columns)}")
+        values = {name: np.asarray(columns[name], dtype=np.double) for name in self.columns}
+        if any(len(column) != count for column in values.values()):
+            raise ValueError("Every field should have one value per timestamp")
+        if count and (np.any(timestamps[1:] <= timestamps[:-1]) or (len(self) and timestamps[0] <= self.timestamps[-1])):
+            raise ValueError("Appended bars should be in time order, after the last bar")
+
+        length = len(self)
+        storage = self._storage
+        lineage = self.lineage
+        if storage is not None and storage.length != length:
+            # something was already appended to this snapshot; branch off with a copy
+            storage = None
+            lineage = None
+        if storage is None or storage.capacity() < length + count:
+            storage = _GrowableColumns(self.timestamps, self.columns, max(2 * (length + count), MIN_APPEND_CAPACITY))
+        storage.timestamps[length:length + count] = timestamps
+        for name, column in values.items():
+            storage.columns[name][length:length + count] = column
+        storage.length = length + count
+
+        end = storage.length
+        return PriceSeries(self.symbol, storage.timestamps[:end],
+                           {name: column[:end] for name, column in storage.columns.items()}, storage, lineage)
+
+def _end_of(end):
+    # a bare date as the upper bound includes every bar of that day
+    bound = np.datetime64(end)
+    if bound.dtype == np.dtype("datetime64[D]"):
+        return (bound + np.timedelta64(1, "D")).astype("datetime64[s]") - np.timedelta64(1, "s")
+    return bound.astype("datetime64[s]")
+
+def load_csv(path, symbol=None):
+    # parsed by the C engine (c_engine/csv_parser.h), which returns contiguous columns already sorted
+    from wrapper import parse_price_csv
+    symbol = symbol or os.path.splitext(os.path.basename(path))[0].upper()
+    timestamps, columns = parse_price_csv(path)
+    return PriceSeries(symbol, timestamps, columns)
+
+def load_price_file(path):
+    # zero-copy: the columns are views of the file mapped by the C engine
+    from wrapper import open_price_file
+    symbol, timestamps, columns = open_price_file(path)
+    symbol = (symbol or os.path.splitext(os.path.basename(path))[0]).upper()
+    return PriceSeries(symbol, timestamps, columns)
+
+class PriceStore:
+    # symbol -> PriceSeries, shared by all requests. Series are immutable once loaded; `load_directory`
+    # swaps in a new mapping, so readers never see a partially loaded symbol
+    def __init__(self):
+        self._series = {}
+        self._lock = threading.Lock()
+
+    def load_directory(self, data_dir):
+        loaded = {}
+        names = sorted(os.listdir(data_dir)) if os.path.isdir(data_dir) else []
+        for name in names:
+            if name.lower().endswith(".prices"):
+                series = load_price_file(os.path.join(data_dir, name))
+                if len(series):
+                    loaded[series.symbol] = series
+        for name in names:
+            if name.lower().endswith(".csv"):
+                series = load_csv(os.path.join(data_dir, name))
+                if len(series) and series.symbol not in loaded:
+                    loaded[series.symbol] = series
+        with self._lock:
+            self._series = {**self._series, **loaded}
+        return sorted(loaded)
+
+    def append(self, symbol, timestamps, columns):
+        # appends bars to a loaded symbol (see PriceSeries.appended) and returns the new series;
+        # raises KeyError for an unknown symbol
+        with self._lock:
+            series = self.get(symbol).appended(timestamps, columns)
+            self._series = {**self._series, series.symbol: series}
+        return series
+
+    def symbols(self):
+        return sorted(self._series)
+
+    def get(self, symbol):
+        series = self._series.get(symbol.upper())
+        if series is None:
+            raise KeyError(symbol)
+        return series
@@ -1,204 +1,431 @@
 # Python bridge between FastAPI and C shared library using cffi
-from cffi import FFI
-ffi = FFI() # Foreign Function Interface
+import os
 import numpy as np
 
-ffi.cdef("""
-void c_free(void *ptr);
-double *compute_SMA(double *prices, int length, int window);
-double *compute_EMA(double *prices, int length, int window);
-double *compute_RSI(double *prices, int length, int window);
-int compute_std_devs(double *prices, int length, int window, double *means, double *std_devs);
-typedef struct
-{
-    double *middle_band;
-    double *top_band;
-    double *bottom_band;
-    int length;
-} BollingerBands;
-void cleanup_bands(BollingerBands *band_values);
-BollingerBands *compute_bollinger_bands(double *prices, int length, int window, double std_devs);
-typedef struct
-{
-    int length;
-    double *MACD_Values;
-    double *signal_line_Values;
-} MACD;
-int cleanup_MACD(MACD *macd);
-MACD *compute_MACD(double *prices, int length);
-double *compute_OBV(const double *prices, const double *volumes, int length);
-""")
-
-# Load the shared library with ffi.dlopen(...)
-lib = ffi.dlopen("../c_engine/indicators.so")
+# Prefer the compiled API-mode extension (`make python` in c_engine): its argument conversion is
+# generated C, so calls skip libffi. Otherwise load indicators.so in ABI mode with the same
+# declarations, relative to this file so the working directory does not matter
+try:
+    try:
+        from ._indicators import ffi, lib
+    except ImportError:
+        from _indicators import ffi, lib
+    API_MODE = True
+except ImportError:
+    from cffi import FFI
+    try:
+        from .indicators_cdef import CDEF
+    except ImportError:
+        from indicators_cdef import CDEF
+
+    ffi = FFI() # Foreign Function Interface
+    ffi.cdef(CDEF)
+    lib = ffi.dlopen(os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "c_engine", "indicators.so"))
+    API_MODE = False
+
+# INDICATOR_SIMD caps the instruction set of the vectorized kernels (scalar, avx2 or avx512); by
+# default the widest one the CPU supports is used, including for the SMA and Bollinger rolling sums,
+# which then agree with the incremental streams within SIMD_RELATIVE_TOLERANCE. INDICATOR_ROLLING_SIMD=0
+# keeps those on the scalar kernels, which are bit-identical to the streams
+SIMD_LEVELS = {"scalar": lib.SIMD_SCALAR, "avx2": lib.SIMD_AVX2, "avx512": lib.SIMD_AVX512}
+if os.getenv("INDICATOR_SIMD") in SIMD_LEVELS:
+    lib.set_simd_level(SIMD_LEVELS[os.getenv("INDICATOR_SIMD")])
+if os.getenv("INDICATOR_ROLLING_SIMD") == "0":
+    lib.set_rolling_simd(0)
 
 # wrap functions
+# Inputs are passed to C as pointers into contiguous float64 NumPy buffers (ffi.from_buffer, no copy
+# when the caller already has one) and results are written by the `_into` C functions straight into
+# preallocated NumPy arrays, so no Python-level loop touches individual values.
+def _as_doubles(values):
+    # contiguous float64 array; only copies when `values` is a list or another dtype / layout
+    return np.ascontiguousarray(values, dtype=np.double)
+
+def _ptr(arr):
+    # C double * into the array's memory. The cdata keeps `arr` alive while it is referenced
+    return ffi.from_buffer("double[]", arr)
+
+def _check(status):
+    if status != 0:
+        raise RuntimeError("C function failed")
+
 def compute_SMA(prices, window):
-    # converts prices to a numpy array of doubles -> data verification
-    prices_arr = np.asarray(prices, dtype=np.double)
+    prices_arr = _as_doubles(prices)
     length = len(prices_arr)
-    
+
     # data verification
     if window <= 0 or window > length:
         raise ValueError("Invalid window size")
-    
-    # crate a C array using the values from the numpy array
-    c_prices = ffi.new("double[]", prices_arr.tolist())  # cast to list for iterable format
-    
-    # run C function. store results in pointer
-    result_ptr = lib.compute_SMA(c_prices, length, window) 
-    if result_ptr == ffi.NULL:
-        raise RuntimeError("C function returned NULL")
-
-    # copy results into new numpy array 
-    result_length = length - window + 1
-    result = np.array([result_ptr[i] for i in range(result_length)])
-    
-    lib.c_free(result_ptr)
 
+    result = np.empty(length - window + 1, dtype=np.double)
+    _check(lib.compute_SMA_into(_ptr(prices_arr), length, window, _ptr(result)))
     return result
 
 def compute_EMA(prices, window):
-    # converts prices to a numpy array of doubles -> data verification
-    prices_arr = np.asarray(prices, dtype=np.double)
+    prices_arr = _as_doubles(prices)
     length = len(prices_arr)
 
     # data verification
     if window <= 0 or window > length:
         raise ValueError("Invalid window size")
-    
-    # crate a C array using the values from the numpy array
-    c_prices = ffi.new("double[]", prices_arr.tolist()) 
-    
-    # run C function. store results in pointer
-    result_ptr = lib.compute_EMA(c_prices, length, window)
-    if result_ptr == ffi.NULL:
-        raise RuntimeError("C function returned NULL")
-
-    # copy results into new numpy array 
-    result_length = length - window + 1
-    result = np.array([result_ptr[i] for i in range(result_length)])
-    
-    lib.c_free(result_ptr)
 
+    result = np.empty(length - window + 1, dtype=np.double)
+    _check(lib.compute_EMA_into(_ptr(prices_arr), length, window, _ptr(result)))
     return result
 
 def compute_RSI(prices, window):
-    # converts prices to a numpy array of doubles -> data verification
-    prices_arr = np.asarray(prices, dtype=np.double)
+    prices_arr = _as_doubles(prices)
     length = len(prices_arr)
 
     # data verification
-    if window <= 0 or window > length:
+    if window <= 0 or window >= length:
         raise ValueError("Invalid window size")
-    
-    # crate a C array using the values from the numpy array
-    c_prices = ffi.new("double[]", prices_arr.tolist()) 
-
-    # run C function. store results in pointer
-    result_ptr = lib.compute_RSI(c_prices, length, window)
-    if result_ptr == ffi.NULL:
-        raise RuntimeError("C function returned NULL")
-    
-    # copy results into new numpy array 
-    result_length = length - window + 1
-    result = np.array([result_ptr[i] for i in range(result_length)])
-    
-    lib.c_free(result_ptr)
 
+    result = np.empty(length - window, dtype=np.double)
+    _check(lib.compute_RSI_into(_ptr(prices_arr), length, window, _ptr(result)))
     return result
-    
+
 def compute_bollinger_bands(prices, window, std_devs): # std_devs is the COUNT of standard deviations, not the malloc ed array
-    # converts prices to a numpy array of doubles -> data verification
-    prices_arr = np.asarray(prices, dtype=np.double)
+    prices_arr = _as_doubles(prices)
     length = len(prices_arr)
 
     # data verification
     if window <= 0 or window > length:
         raise ValueError("Invalid window size")
-    
-    # crate a C array using the values from the numpy array
-    c_prices = ffi.new("double[]", prices_arr.tolist()) 
-
-    # run C function. store results in pointer
-    result_ptr = lib.compute_bollinger_bands(c_prices, length, window, std_devs)
-    if result_ptr == ffi.NULL:
-        raise RuntimeError("C function returned NULL")
-    
-    # copy struct into new numpy array 
-    result = result_ptr[0]
-
-    if result.middle_band == ffi.NULL or result.top_band == ffi.NULL or result.bottom_band == ffi.NULL:
-        lib.cleanup_bands(result_ptr)
-        raise RuntimeError("Band arrays were not allocated properly")
-
-    n = result.length
-
-    middle = np.frombuffer(ffi.buffer(result.middle_band, n * 8), dtype=np.double).copy()
-    top    = np.frombuffer(ffi.buffer(result.top_band,    n * 8), dtype=np.double).copy()
-    bottom = np.frombuffer(ffi.buffer(result.bottom_band, n * 8), dtype=np.double).copy()
 
-    lib.cleanup_bands(result_ptr)
-
-    return np.stack([bottom, middle, top], axis=1) # 2-D numpy array of (result_length, 3)
+    # the C function fills three contiguous rows: bottom, middle, top
+    bands = np.empty((3, length - window + 1), dtype=np.double)
+    _check(lib.compute_bollinger_bands_into(_ptr(prices_arr), length, window, std_devs,
+                                            _ptr(bands[1]), _ptr(bands[2]), _ptr(bands[0])))
+    return bands.T # 2-D numpy array of (result_length, 3): bottom, middle, top
 
 def compute_MACD(prices):
-    if (prices == None or len(prices) == 0):
+    if prices is None or len(prices) == 0:
         raise RuntimeError("Invalid prices array")
-                           
-    # converts prices to a numpy array of doubles -> data verification
-    prices_arr = np.asarray(prices, dtype=np.double)
-    length = len(prices_arr)
-
-    # crate a C array using the values from the numpy array
-    c_prices = ffi.new("double[]", prices_arr.tolist()) 
-
-    # run C function. store results in pointer
-    result_ptr = lib.compute_MACD(c_prices, length)
-    if result_ptr == ffi.NULL:
-        raise RuntimeError("C function returned NULL")
-    
-    # copy struct into new numpy array 
-    result = result_ptr[0]
-
-    if result.MACD_Values == ffi.NULL or result.signal_line_Values == ffi.NULL:
-        lib.cleanup_MACD(result_ptr)
-        raise RuntimeError("MACD arrays were not allocated properly")
-
-    n = result.length
 
-    MACD = np.frombuffer(ffi.buffer(result.MACD_Values, n * 8), dtype=np.double).copy()
-    signal = np.frombuffer(ffi.buffer(result.signal_line_Values, n * 8), dtype=np.double).copy()
+    prices_arr = _as_doubles(prices)
+    length = len(prices_arr)
 
-    lib.cleanup_MACD(result_ptr)
+    result_length = lib.compute_output_length(lib.INDICATOR_MACD, length, 0)
+    if result_length <= 0:
+        raise ValueError("Not enough prices for MACD")
 
-    return np.stack([MACD, signal], axis=1)
+    # the C function fills three contiguous rows: MACD, signal line, histogram
+    lines = np.empty((3, result_length), dtype=np.double)
+    _check(lib.compute_MACD_periods_into(_ptr(prices_arr), length,
+                                         lib.MACD_FAST_PERIOD, lib.MACD_SLOW_PERIOD, lib.MACD_SIGNAL_PERIOD,
+                                         _ptr(lines[0]), _ptr(lines[1]), _ptr(lines[2])))
+    return lines.T # 2-D numpy array of (result_length, 3): MACD, signal, histogram
 
 def compute_OBV(prices, volumes):
-    if prices is None or volumes is None: 
+    if prices is None or volumes is None:
         raise ValueError("Invalid arguments")
 
-    # converts prices to a numpy array of doubles -> data verification
-    prices_arr = np.asarray(prices, dtype=np.double)
-    volume_arr = np.asarray(volumes, dtype=np.double)
+    prices_arr = _as_doubles(prices)
+    volume_arr = _as_doubles(volumes)
     length = len(prices_arr)
 
-    if (len(prices) != len(volumes)):
+    if len(prices_arr) != len(volume_arr):
         raise ValueError("Prices and volumes array should be the same length")
-    
-    # crate a C array using the values from the numpy array
-    c_prices = ffi.new("double[]", prices_arr.tolist()) 
-    c_volumes = ffi.new("double[]", volume_arr.tolist()) 
-    
-    # run C function. store results in pointer
-    result_ptr = lib.compute_OBV(c_prices, c_volumes, length)
-    if result_ptr == ffi.NULL:
-        raise RuntimeError("C function returned NULL")
-
-    # copy results into new numpy array 
-    result_length = length
-    result = np.array([result_ptr[i] for i in range(result_length)])
-    
-    lib.c_free(result_ptr)
-
-    return result
\ No newline at end of file
+
+    result = np.empty(length, dtype=np.double)
+    _check(lib.compute_OBV_into(_ptr(prices_arr), _ptr(volume_arr), length, _ptr(result)))
+    return result
+
+INDICATOR_TYPES = {
+    "sma": lib.INDICATOR_SMA,
+    "ema": lib.INDICATOR_EMA,
+    "rsi": lib.INDICATOR_RSI,
+    "bollinger_bands": lib.INDICATOR_BOLLINGER,
+    "macd": lib.INDICATOR_MACD,
+    "obv": lib.INDICATOR_OBV,
+}
+
+def make_spec(indicator, window=0, std_devs=2.0, fast_period=12, slow_period=26, signal_period=9):
+    if indicator not in INDICATOR_TYPES:
+        raise ValueError(f"Unknown indicator: {indicator}")
+
+    return ffi.new("IndicatorSpec *", {
+        "type": INDICATOR_TYPES[indicator],
+        "window": window,
+        "std_devs": std_devs,
+        "fast_period": fast_period,
+        "slow_period": slow_period,
+        "signal_period": signal_period,
+    })
+
+def _make_specs(indicators):
+    # indicators is a list of dicts like {"indicator": "sma", "window": 20}
+    specs = ffi.new("IndicatorSpec[]", len(indicators))
+    for i, params in enumerate(indicators):
+        params = dict(params)
+        specs[i] = make_spec(params.pop("indicator"), **params)[0]
+        if lib.indicator_lead(ffi.addressof(specs, i)) < 0:
+            raise ValueError("Invalid indicator parameters")
+    return specs
+
+def _defined_values(spec, aligned, length):
+    # drops the NaN warm-up of an aligned (planes, length) output and lays it out like the
+    # single-indicator functions: 1-D, or (n, 3) with Bollinger columns bottom, middle, top
+    if spec.type == lib.INDICATOR_MACD:
+        count = lib.compute_MACD_output_length(length, spec.fast_period, spec.slow_period, spec.signal_period)
+    else:
+        count = lib.compute_output_length(spec.type, length, spec.window)
+    values = aligned[:, length - count:] if count > 0 else aligned[:, :0]
+    if spec.type == lib.INDICATOR_BOLLINGER:
+        return values[[2, 0, 1]].T
+    if spec.type == lib.INDICATOR_MACD:
+        return values.T
+    return values[0]
+
+def compute_indicator_set(prices, indicators, volumes=None):
+    # computes every indicator of the list over one series in a single C call, which shares work
+    # between them (equal specs, SMA and Bollinger middle band, one pass for RSI and OBV).
+    # Returns one array per indicator, shaped like the matching compute_* function's result
+    prices_arr = _as_doubles(prices)
+    length = len(prices_arr)
+    volume_arr = None
+    if volumes is not None:
+        volume_arr = _as_doubles(volumes)
+        if len(volume_arr) != length:
+            raise ValueError("Prices and volumes array should be the same length")
+
+    specs = _make_specs(indicators)
+    outs = [np.empty((lib.indicator_output_planes(specs[i].type), length), dtype=np.double)
+            for i in range(len(indicators))]
+    out_ptrs = ffi.new("double *[]", [_ptr(out) for out in outs])
+    _check(lib.compute_indicator_set(specs, len(indicators), _ptr(prices_arr),
+                                     _ptr(volume_arr) if volume_arr is not None else ffi.NULL, length, out_ptrs))
+    return [_defined_values(specs[i], outs[i], length) for i in range(len(indicators))]
+
+def _make_panel(prices, volumes, lengths):
+    # prices is a 2-D (symbols, time) array. A C-ordered array is passed as a row-major panel and a
+    # Fortran-ordered one (e.g. the transpose of a (time, symbols) table) as column-major, both without copying
+    prices_arr = np.asarray(prices, dtype=np.double)
+    if prices_arr.ndim != 2:
+        raise ValueError("prices must be a 2-D (symbols, time) array")
+    if not prices_arr.flags.c_contiguous and not prices_arr.flags.f_contiguous:
+        prices_arr = np.ascontiguousarray(prices_arr)
+    column_major = not prices_arr.flags.c_contiguous
+    order = "F" if column_major else "C"
+    symbols, time_steps = prices_arr.shape
+
+    panel = ffi.new("PricePanel *")
+    keep_alive = [prices_arr] # buffers referenced by the panel must outlive the C call
+    panel.prices = ffi.from_buffer("double[]", prices_arr.ravel(order="K"))
+    panel.symbols = symbols
+    panel.time_steps = time_steps
+    panel.layout = lib.PANEL_COLUMN_MAJOR if column_major else lib.PANEL_ROW_MAJOR
+
+    if volumes is not None:
+        volume_arr = np.asarray(volumes, dtype=np.double, order=order)
+        if volume_arr.shape != prices_arr.shape:
+            raise ValueError("Prices and volumes should have the same shape")
+        keep_alive.append(volume_arr)
+        panel.volumes = ffi.from_buffer("double[]", volume_arr.ravel(order="K"))
+    if lengths is not None:
+        length_arr = np.ascontiguousarray(lengths, dtype=np.intc)
+        if length_arr.shape != (symbols,):
+            raise ValueError("lengths should have one entry per symbol")
+        keep_alive.append(length_arr)
+        panel.lengths = ffi.from_buffer("int[]", length_arr)
+
+    return panel, keep_alive
+
+def _panel_output(panel, spec):
+    planes = lib.indicator_output_planes(spec.type)
+    if panel.layout == lib.PANEL_COLUMN_MAJOR:
+        return np.empty((planes, panel.time_steps, panel.symbols), dtype=np.double)
+    return np.empty((planes, panel.symbols, panel.time_steps), dtype=np.double)
+
+def _as_symbols_by_time(panel, out):
+    # (planes, symbols, time) with warm-up and padding positions set to NaN
+    return out.transpose(0, 2, 1) if panel.layout == lib.PANEL_COLUMN_MAJOR else out
+
+def compute_panel(prices, indicator, volumes=None, lengths=None, **params):
+    panel, keep_alive = _make_panel(prices, volumes, lengths)
+    spec = make_spec(indicator, **params)
+    if lib.indicator_lead(spec) < 0:
+        raise ValueError("Invalid indicator parameters")
+
+    out = _panel_output(panel, spec)
+    if lib.compute_panel(panel, spec, ffi.from_buffer("double[]", out)) != 0:
+        raise RuntimeError("C function failed")
+    return _as_symbols_by_time(panel, out)
+
+_thread_pool = None
+
+def get_thread_pool():
+    # one process-wide pool; INDICATOR_THREADS sets its size (0 or unset uses every online CPU)
+    global _thread_pool
+    if _thread_pool is None:
+        pool = lib.init_thread_pool(int(os.getenv("INDICATOR_THREADS", "0")))
+        if pool == ffi.NULL:
+            raise RuntimeError("Could not start the indicator thread pool")
+        _thread_pool = ffi.gc(pool, lib.cleanup_thread_pool)
+    return _thread_pool
+
+def compute_panel_parallel(prices, indicators, volumes=None, lengths=None):
+    # indicators is a list of dicts like {"indicator": "sma", "window": 20}; all of them are computed
+    # for every symbol in one job on the thread pool. Returns one (planes, symbols, time) array each
+    panel, keep_alive = _make_panel(prices, volumes, lengths)
+    specs = _make_specs(indicators)
+
+    outs = [_panel_output(panel, specs[i]) for i in range(len(indicators))]
+    out_buffers = [ffi.from_buffer("double[]", out) for out in outs]
+    out_ptrs = ffi.new("double *[]", out_buffers)
+
+    if lib.compute_panel_parallel(get_thread_pool(), panel, specs, len(indicators), out_ptrs) != 0:
+        raise RuntimeError("C function failed")
+    return [_as_symbols_by_time(panel, out) for out in outs]
+
+PRICE_FILE_FIELDS = ("open", "high", "low", "close", "volume")
+
+def open_price_file(path):
+    # maps a columnar price file (c_engine/price_file.h) and returns (symbol, timestamps, columns):
+    # datetime64[s] timestamps and a dict of float64 columns, all read-only views of the mapping.
+    # The file is unmapped once every view has been released
+    handle = lib.open_price_file(os.fsencode(path))
+    if handle == ffi.NULL:
+        raise ValueError(f"Could not open price file {path}")
+    # the mapping's lifetime is tied to a cdata that every view's buffer references
+    mapping = ffi.gc(ffi.cast("char *", handle.mapping), lambda _: lib.close_price_file(handle))
+    whole = np.frombuffer(ffi.buffer(mapping, handle.mapping_size), dtype=np.uint8)
+    base = int(ffi.cast("uintptr_t", handle.mapping))
+    rows = handle.rows
+
+    def column(pointer, dtype):
+        offset = int(ffi.cast("uintptr_t", pointer)) - base
+        return whole[offset:offset + rows * 8].view(dtype)
+
+    timestamps = column(handle.timestamps, np.int64).view("datetime64[s]")
+    columns = {name: column(getattr(handle, name), np.double) for name in PRICE_FILE_FIELDS}
+    return ffi.string(handle.symbol).decode(), timestamps, columns
+
+def write_price_file(path, symbol, timestamps, columns):
+    # timestamps: anything convertible to datetime64[s]; columns: dict with every PRICE_FILE_FIELDS entry
+    seconds = np.ascontiguousarray(np.asarray(timestamps, dtype="datetime64[s]").astype(np.int64))
+    arrays = [_as_doubles(columns[name]) for name in PRICE_FILE_FIELDS]
+    if any(len(array) != len(seconds) for array in arrays):
+        raise ValueError("Every column should have one value per timestamp")
+    _check(lib.write_price_file(os.fsencode(path), symbol.encode(), len(seconds),
+                                ffi.from_buffer("int64_t[]", seconds), *[_ptr(array) for array in arrays]))
+
+def parse_price_csv(path):
+    # parses an OHLCV CSV with the C parser (chunks of large files in parallel on the thread pool) and
+    # returns (timestamps, columns) like open_price_file, oldest bar first. Only the fields present in
+    # the file are returned; the arrays are views of one C allocation, freed with the last of them
+    handle = lib.parse_price_csv(os.fsencode(path), get_thread_pool())
+    if handle == ffi.NULL:
+        raise ValueError(f"Could not parse price CSV {path}")
+    rows = handle.rows
+    present = [name for k, name in enumerate(PRICE_FILE_FIELDS) if handle.fields & (1 << k)]
+    if rows == 0:
+        lib.free_price_columns(handle)
+        return np.empty(0, dtype="datetime64[s]"), {name: np.empty(0) for name in present}
+
+    block = ffi.gc(ffi.cast("char *", handle.timestamps), lambda _: lib.free_price_columns(handle))
+    whole = np.frombuffer(ffi.buffer(block, rows * 8 * (len(PRICE_FILE_FIELDS) + 1)), dtype=np.uint8)
+    timestamps = whole[:rows * 8].view(np.int64).view("datetime64[s]")
+    columns = {name: whole[(k + 1) * rows * 8:(k + 2) * rows * 8].view(np.double)
+               for k, name in enumerate(PRICE_FILE_FIELDS) if name in present}
+    return timestamps, columns
+
+def hash_series(*series, seed=0):
+    # 64-bit fingerprint of one or more float64 series, computed in C over the raw values; None
+    # entries (e.g. absent volumes) hash differently from empty series. Not collision resistant:
+    # use it to find candidates, then compare the values
+    state = seed
+    for values in series:
+        if values is None:
+            state = lib.hash_series(ffi.NULL, 0, (state + 1) & 0xFFFFFFFFFFFFFFFF)
+        else:
+            values = _as_doubles(values)
+            state = lib.hash_series(_ptr(values), len(values), state)
+    return state
+
+STREAM_INDICATORS = ("sma", "ema", "rsi", "macd", "obv")
+
+class IndicatorStream:
+    # one indicator over a growing series, kept as the C stream's tail state (running sum, last EMA,
+    # Wilder averages, last OBV). extend() takes the new bars and returns only their outputs, so each
+    # update costs O(new bars). The first call takes the whole history and returns the same values
+    # as the matching compute_* function (bit for bit with INDICATOR_ROLLING_SIMD=0)
+    def __init__(self, indicator, window=0, fast_period=12, slow_period=26, signal_period=9):
+        if indicator not in STREAM_INDICATORS:
+            raise ValueError(f"No streaming form of {indicator}")
+        self.indicator = indicator
+        self.window = window
+        self.periods = (fast_period, slow_period, signal_period)
+        self._handle = None
+
+    def output_length(self, length):
+        # outputs for a series of `length` bars, as for the batch function (<= 0 if too short)
+        if self.indicator == "macd":
+            return lib.compute_MACD_output_length(length, *self.periods)
+        return lib.compute_output_length(INDICATOR_TYPES[self.indicator], length, self.window)
+
+    def warmup(self):
+        # bars consumed before the first output
+        if self.indicator == "macd":
+            return self.periods[1] + self.periods[2] - 1
+        return {"sma": self.window, "ema": self.window, "rsi": self.window + 1, "obv": 1}[self.indicator]
+
+    def extend(self, prices, volumes=None):
+        prices_arr = _as_doubles(prices)
+        volume_arr = None
+        if self.indicator == "obv":
+            if volumes is None or len(volumes) != len(prices_arr):
+                raise ValueError("Prices and volumes array should be the same length")
+            volume_arr = _as_doubles(volumes)
+
+        if self._handle is None:
+            if self.output_length(len(prices_arr)) <= 0:
+                raise ValueError("Not enough prices for the indicator")
+            seed = self.warmup()
+            self._handle = self._init(prices_arr[:seed], None if volume_arr is None else volume_arr[:seed])
+            first = self._current()
+            rest = self._append(prices_arr[seed:], None if volume_arr is None else volume_arr[seed:])
+            return np.concatenate([first, rest])
+        return self._append(prices_arr, volume_arr)
+
+    def _init(self, prices, volumes):
+        length = len(prices)
+        if self.indicator == "sma":
+            handle = ffi.gc(lib.init_SMA_stream(_ptr(prices), length, self.window), lib.cleanup_SMA_stream)
+        elif self.indicator == "ema":
+            handle = ffi.gc(lib.init_EMA_stream(_ptr(prices), length, self.window), lib.cleanup_EMA_stream)
+        elif self.indicator == "rsi":
+            handle = ffi.gc(lib.init_RSI_stream(_ptr(prices), length, self.window), lib.cleanup_RSI_stream)
+        elif self.indicator == "macd":
+            handle = ffi.gc(lib.init_MACD_stream(_ptr(prices), length, *self.periods), lib.cleanup_MACD_stream)
+        else:
+            handle = ffi.gc(lib.init_OBV_stream(_ptr(prices), _ptr(volumes), length), lib.cleanup_OBV_stream)
+        if handle == ffi.NULL:
+            raise RuntimeError("C function failed")
+        return handle
+
+    def _current(self):
+        # the output for the bars consumed so far, shaped like one row of append()
+        if self.indicator == "macd":
+            point = ffi.new("MACDPoint *")
+            _check(lib.get_MACD_stream_point(self._handle, point))
+            return np.array([[point.MACD_Value, point.signal_line_Value, point.histogram_Value]])
+        get = {"sma": lib.get_SMA_stream_value, "ema": lib.get_EMA_stream_value,
+               "rsi": lib.get_RSI_stream_value, "obv": lib.get_OBV_stream_value}[self.indicator]
+        return np.array([get(self._handle)])
+
+    def _append(self, prices, volumes):
+        count = len(prices)
+        if self.indicator == "macd":
+            lines = np.empty((3, count), dtype=np.double)
+            _check(lib.append_MACD_stream(self._handle, _ptr(prices), count,
+                                          _ptr(lines[0]), _ptr(lines[1]), _ptr(lines[2])))
+            return lines.T # (count, 3): MACD, signal, histogram
+        result = np.empty(count, dtype=np.double)
+        if self.indicator == "obv":
+            _check(lib.append_OBV_stream(self._handle, _ptr(prices), _ptr(volumes), count, _ptr(result)))
+        else:
+            append = {"sma": lib.append_SMA_stream, "ema": lib.append_EMA_stream, "rsi": lib.append_RSI_stream}
+            _check(append[self.indicator](self._handle, _ptr(prices), count, _ptr(result)))
+        return result
@@ -0,0 +1,696 @@
+/**
+ * csv_parser.c
+ * ------------
+ * Parses OHLCV CSV text into the columns described in csv_parser.h.
+ *
+ * The text after the header is split at line boundaries into chunks. A first pass counts
+ * the rows of every chunk, which gives each chunk its first output row; a second pass
+ * parses every chunk straight into its part of the columns. Both passes run one task per
+ * chunk on the thread pool, so no chunk waits for another and the output needs no merge.
+ */
+
+#include "csv_parser.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <string.h>
+#include <math.h>
+
+#define CSV_MAX_COLUMNS 64                  // header columns that can be mapped to a role
+#define CSV_MIN_CHUNK_BYTES (256 * 1024)    // smaller inputs are parsed as one chunk
+#define CSV_CHUNKS_PER_WORKER 4             // extra chunks let the pool balance uneven ones
+#define CSV_MAX_NUMBER_LENGTH 64            // longest field handed to the strtod() fallback
+#define MAX_EXACT_MANTISSA (1ULL << 53)     // integers up to here are exact doubles
+
+enum
+{
+    ROLE_NONE = -1,
+    ROLE_TIMESTAMP = 0, // roles 1 .. PRICE_FIELD_COUNT are the price fields in column order
+    PRICE_FIELD_COUNT = 5
+};
+
+static const char *const FIELD_NAMES[PRICE_FIELD_COUNT] = {"open", "high", "low", "close", "volume"};
+static const char *const TIMESTAMP_NAMES[] = {"timestamp", "date", "time", "datetime"};
+
+// every power of ten that is exactly representable as a double
+static const double POWERS_OF_TEN[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                       1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                       1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+typedef struct
+{
+    const char **bounds; // chunk_count + 1 line-aligned boundaries
+    int *rows;           // rows per chunk after the count pass, first output row per chunk after that
+    int *failed;         // per chunk, so workers never share a flag
+    const int *roles;    // role of each header column
+    int columns;         // header columns with a role recorded in `roles`
+    int needed;          // columns with a role other than ROLE_NONE
+    double *fields[PRICE_FIELD_COUNT];
+    int64_t *timestamps;
+} CsvJob;
+
+static int is_blank(char c)
+{
+    return c == ' ' || c == '\t';
+}
+
+/**
+ * Narrows [*start, *end) to the field's contents, without surrounding blanks or quotes.
+ */
+static void trim_field(const char **start, const char **end)
+{
+    const char *s = *start;
+    const char *e = *end;
+    while (s < e && is_blank(*s))
+        s++;
+    while (e > s && is_blank(e[-1]))
+        e--;
+    if (e - s >= 2 && *s == '"' && e[-1] == '"')
+    {
+        for (s++, e--; s < e && is_blank(*s); s++)
+            ;
+        while (e > s && is_blank(e[-1]))
+            e--;
+    }
+    *start = s;
+    *end = e;
+}
+
+/**
+ * The comma ending the field that starts at `p`, or NULL if it runs to `end`. Commas inside
+ * double quotes belong to the field ("" inside quotes is an escaped quote). Fields without
+ * quotes take the memchr() path.
+ */
+static const char *field_separator(const char *p, const char *end)
+{
+    const char *comma = memchr(p, ',', (size_t)(end - p));
+    if (!memchr(p, '"', (size_t)((comma ? comma : end) - p)))
+        return comma;
+    int quoted = 0;
+    for (; p < end; p++)
+    {
+        if (*p == '"')
+            quoted = !quoted;
+        else if (*p == ',' && !quoted)
+            return p;
+    }
+    return NULL;
+}
+
+/**
+ * End of the line starting at `line`, excluding the newline and a preceding '\r'.
+ * `*next` receives the start of the following line.
+ */
+static const char *line_end(const char *line, const char *limit, const char **next)
+{
+    const char *newline = memchr(line, '\n', (size_t)(limit - line));
+    const char *end = newline ? newline : limit;
+    *next = newline ? newline + 1 : limit;
+    if (end > line && end[-1] == '\r')
+        end--;
+    return end;
+}
+
+/**
+ * Parses a number with strtod() for the rare fields the fast path cannot convert exactly
+ * (more than 19 significant digits, large exponents, nan, inf).
+ */
+static int parse_double_slow(const char *start, const char *end, double *out)
+{
+    char buffer[CSV_MAX_NUMBER_LENGTH + 1];
+    size_t length = (size_t)(end - start);
+    if (length > CSV_MAX_NUMBER_LENGTH)
+        return 0;
+    memcpy(buffer, start, length);
+    buffer[length] = '\0';
+    char *parsed;
+    *out = strtod(buffer, &parsed);
+    return parsed == buffer + length;
+}
+
+/**
+ * Parses a decimal number. A mantissa of at most 2^53 scaled by at most 10^22 is exact in
+ * both operands, so one IEEE multiplication or division rounds it correctly; every other
+ * input takes the strtod() path. Either way the result equals strtod()'s.
+ */
+static int parse_double(const char *start, const char *end, double *out)
+{
+    trim_field(&start, &end);
+    if (start == end)
+    {
+        *out = NAN;
+        return 1;
+    }
+
+    const char *p = start;
+    int negative = (*p == '-');
+    if (*p == '-' || *p == '+')
+        p++;
+
+    uint64_t mantissa = 0;
+    int significant = 0; // digits accumulated in `mantissa`, not counting leading zeros
+    int exponent = 0;
+    int digits = 0;
+    for (; p < end && *p >= '0' && *p <= '9'; p++, digits++)
+    {
+        if (mantissa == 0 && *p == '0')
+            continue;
+        if (++significant > 19)
+            return parse_double_slow(start, end, out);
+        mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+    }
+    if (p < end && *p == '.')
+    {
+        for (p++; p < end && *p >= '0' && *p <= '9'; p++, digits++)
+        {
+            exponent--;
+            if (mantissa == 0 && *p == '0')
+                continue;
+            if (++significant > 19)
+                return parse_double_slow(start, end, out);
+            mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+        }
+    }
+    if (digits == 0)
+        return parse_double_slow(start, end, out);
+    if (p < end && (*p == 'e' || *p == 'E'))
+    {
+        p++;
+        int exponent_negative = (p < end && *p == '-');
+        if (p < end && (*p == '-' || *p == '+'))
+            p++;
+        if (p == end || *p < '0' || *p > '9')
+            return 0;
+        int value = 0;
+        for (; p < end && *p >= '0' && *p <= '9'; p++)
+        {
+            if (value > 10000)
+                return parse_double_slow(start, end, out);
+            value = value * 10 + (*p - '0');
+        }
+        exponent += exponent_negative ? -value : value;
+    }
+    if (p != end)
+        return 0;
+
+    if (mantissa > MAX_EXACT_MANTISSA || exponent < -22 || exponent > 22)
+        return parse_double_slow(start, end, out);
+    double value = (double)mantissa;
+    value = (exponent < 0) ? value / POWERS_OF_TEN[-exponent] : value * POWERS_OF_TEN[exponent];
+    *out = negative ? -value : value;
+    return 1;
+}
+
+/**
+ * Reads exactly `count` digits. Returns -1 if any character is not a digit.
+ */
+static int parse_digits(const char *p, int count)
+{
+    int value = 0;
+    for (int i = 0; i < count; i++)
+    {
+        if (p[i] < '0' || p[i] > '9')
+            return -1;
+        value = value * 10 + (p[i] - '0');
+    }
+    return value;
+}
+
+/**
+ * Days from 1970-01-01 to the given proleptic Gregorian date.
+ */
+static int64_t days_from_civil(int64_t year, int month, int day)
+{
+    year -= (month <= 2);
+    int64_t era = (year >= 0 ? year : year - 399) / 400;
+    int64_t year_of_era = year - era * 400;
+    int64_t day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    int64_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return era * 146097 + day_of_era - 719468;
+}
+
+/**
+ * Number of days in `month` (1-12) of the proleptic Gregorian `year`.
+ */
+static int days_in_month(int year, int month)
+{
+    static const int days[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    int leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    return days[month - 1] + (month == 2 && leap);
+}
+
+/**
+ * Parses `YYYY-MM-DD[( |T)HH:MM[:SS]]` or integer epoch seconds into epoch seconds.
+ */
+static int parse_timestamp(const char *start, const char *end, int64_t *out)
+{
+    trim_field(&start, &end);
+    ptrdiff_t length = end - start;
+    if (length >= 10 && start[4] == '-' && start[7] == '-')
+    {
+        int year = parse_digits(start, 4);
+        int month = parse_digits(start + 5, 2);
+        int day = parse_digits(start + 8, 2);
+        if (year < 0 || month < 1 || month > 12 || day < 1 || day > days_in_month(year, month))
+            return 0;
+        int hour = 0, minute = 0, second = 0;
+        if (length > 10)
+        {
+            if ((length != 16 && length != 19) || (start[10] != ' ' && start[10] != 'T') || start[13] != ':' ||
+                (length == 19 && start[16] != ':'))
+                return 0;
+            hour = parse_digits(start + 11, 2);
+            minute = parse_digits(start + 14, 2);
+            second = (length == 19) ? parse_digits(start + 17, 2) : 0;
+            if (hour < 0 || hour > 23 || minute < 0 || minute > 59 || second < 0 || second > 59)
+                return 0;
+        }
+        *out = days_from_civil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second;
+        return 1;
+    }
+
+    const char *p = start;
+    int negative = (p < end && *p == '-');
+    if (negative)
+        p++;
+    if (p == end || end - p > 18)
+        return 0;
+    int64_t seconds = 0;
+    for (; p < end; p++)
+    {
+        if (*p < '0' || *p > '9')
+            return 0;
+        seconds = seconds * 10 + (*p - '0');
+    }
+    *out = negative ? -seconds : seconds;
+    return 1;
+}
+
+/**
+ * Maps the header columns to roles. Returns the number of columns with a role, or -1 if
+ * there is no timestamp column.
+ */
+static int parse_header(const char *line, const char *end, int *roles, int *columns, unsigned *fields)
+{
+    int needed = 0;
+    int has_timestamp = 0;
+    *columns = 0;
+    *fields = 0;
+    for (const char *p = line; *columns < CSV_MAX_COLUMNS;)
+    {
+        const char *comma = field_separator(p, end);
+        const char *name = p;
+        const char *name_end = comma ? comma : end;
+        trim_field(&name, &name_end);
+        size_t length = (size_t)(name_end - name);
+
+        char lower[16];
+        int role = ROLE_NONE;
+        if (length < sizeof(lower))
+        {
+            for (size_t i = 0; i < length; i++)
+                lower[i] = (name[i] >= 'A' && name[i] <= 'Z') ? (char)(name[i] - 'A' + 'a') : name[i];
+            lower[length] = '\0';
+            for (size_t i = 0; i < sizeof(TIMESTAMP_NAMES) / sizeof(TIMESTAMP_NAMES[0]) && !has_timestamp; i++)
+            {
+                if (strcmp(lower, TIMESTAMP_NAMES[i]) == 0)
+                    role = ROLE_TIMESTAMP;
+            }
+            for (int f = 0; f < PRICE_FIELD_COUNT && role == ROLE_NONE; f++)
+            {
+                if (!(*fields & (1u << f)) && strcmp(lower, FIELD_NAMES[f]) == 0)
+                {
+                    role = f + 1;
+                    *fields |= 1u << f;
+                }
+            }
+        }
+        has_timestamp |= (role == ROLE_TIMESTAMP);
+        needed += (role != ROLE_NONE);
+        roles[(*columns)++] = role;
+
+        if (!comma)
+            break;
+        p = comma + 1;
+    }
+    return has_timestamp ? needed : -1;
+}
+
+/**
+ * Parses one non-blank data line into output row `row`.
+ */
+static int parse_row(const CsvJob *job, const char *line, const char *end, int row)
+{
+    int seen = 0;
+    const char *p = line;
+    for (int column = 0; column < job->columns; column++)
+    {
+        const char *comma = field_separator(p, end);
+        const char *field_end = comma ? comma : end;
+        int role = job->roles[column];
+        if (role == ROLE_TIMESTAMP)
+        {
+            if (!parse_timestamp(p, field_end, &job->timestamps[row]))
+                return 0;
+            seen++;
+        }
+        else if (role != ROLE_NONE)
+        {
+            if (!parse_double(p, field_end, &job->fields[role - 1][row]))
+                return 0;
+            seen++;
+        }
+        if (seen == job->needed)
+            return 1;
+        if (!comma)
+            return 0; // the row has fewer columns than the header
+        p = comma + 1;
+    }
+    return 0;
+}
+
+static void count_chunk(void *context, int task, int worker)
+{
+    (void)worker;
+    CsvJob *job = context;
+    const char *limit = job->bounds[task + 1];
+    int rows = 0;
+    for (const char *line = job->bounds[task]; line < limit;)
+    {
+        const char *next;
+        rows += (line_end(line, limit, &next) > line);
+        line = next;
+    }
+    job->rows[task] = rows;
+}
+
+static void parse_chunk(void *context, int task, int worker)
+{
+    (void)worker;
+    CsvJob *job = context;
+    const char *limit = job->bounds[task + 1];
+    int row = job->rows[task];
+    for (const char *line = job->bounds[task]; line < limit;)
+    {
+        const char *next;
+        const char *end = line_end(line, limit, &next);
+        if (end > line && !parse_row(job, line, end, row++))
+        {
+            job->failed[task] = 1;
+            return;
+        }
+        line = next;
+    }
+}
+
+static void run_chunks(ThreadPool *pool, int chunks, PoolTask task, CsvJob *job)
+{
+    if (pool && chunks > 1)
+    {
+        run_thread_pool(pool, chunks, task, job);
+        return;
+    }
+    for (int c = 0; c < chunks; c++)
+        task(job, c, 0);
+}
+
+/**
+ * Allocates the result with room for `rows` bars in one block of column storage.
+ */
+static PriceColumns *alloc_price_columns(int rows)
+{
+    PriceColumns *result = calloc(1, sizeof(PriceColumns));
+    if (!result)
+        return NULL;
+    result->rows = rows;
+    if (rows == 0)
+        return result;
+
+    double *block = malloc(sizeof(double) * (PRICE_FIELD_COUNT + 1) * (size_t)rows);
+    if (!block)
+    {
+        free(result);
+        return NULL;
+    }
+    result->timestamps = (int64_t *)block;
+    result->open = block + (size_t)rows;
+    result->high = block + 2 * (size_t)rows;
+    result->low = block + 3 * (size_t)rows;
+    result->close = block + 4 * (size_t)rows;
+    result->volume = block + 5 * (size_t)rows;
+    return result;
+}
+
+static double **column_array(PriceColumns *columns, double **fields)
+{
+    fields[0] = columns->open;
+    fields[1] = columns->high;
+    fields[2] = columns->low;
+    fields[3] = columns->close;
+    fields[4] = columns->volume;
+    return fields;
+}
+
+typedef struct
+{
+    int64_t timestamp;
+    int row;
+} RowKey;
+
+static int compare_row_keys(const void *a, const void *b)
+{
+    const RowKey *x = a;
+    const RowKey *y = b;
+    if (x->timestamp != y->timestamp)
+        return (x->timestamp < y->timestamp) ? -1 : 1;
+    return (x->row > y->row) - (x->row < y->row);
+}
+
+/**
+ * Puts the rows in ascending time order, keeping the file order of equal timestamps.
+ * Vendor files are usually newest first, which is a plain reversal.
+ */
+static int sort_rows(PriceColumns *columns)
+{
+    int rows = columns->rows;
+    int ascending = 1, descending = 1;
+    for (int i = 1; i < rows; i++)
+    {
+        ascending &= (columns->timestamps[i - 1] <= columns->timestamps[i]);
+        descending &= (columns->timestamps[i - 1] > columns->timestamps[i]);
+    }
+    if (ascending)
+        return SUCCESS;
+
+    double *fields[PRICE_FIELD_COUNT];
+    column_array(columns, fields);
+    if (descending)
+    {
+        for (int i = 0, j = rows - 1; i < j; i++, j--)
+        {
+            int64_t t = columns->timestamps[i];
+            columns->timestamps[i] = columns->timestamps[j];
+            columns->timestamps[j] = t;
+            for (int f = 0; f < PRICE_FIELD_COUNT; f++)
+            {
+                double v = fields[f][i];
+                fields[f][i] = fields[f][j];
+                fields[f][j] = v;
+            }
+        }
+        return SUCCESS;
+    }
+
+    RowKey *keys = malloc(sizeof(RowKey) * (size_t)rows);
+    PriceColumns *sorted = alloc_price_columns(rows);
+    if (!keys || !sorted)
+    {
+        fprintf(stderr, "Malloc failed. %s.\n", strerror(errno));
+        free(keys);
+        free_price_columns(sorted);
+        return FAILURE;
+    }
+    for (int i = 0; i < rows; i++)
+    {
+        keys[i].timestamp = columns->timestamps[i];
+        keys[i].row = i;
+    }
+    qsort(keys, (size_t)rows, sizeof(RowKey), compare_row_keys);
+
+    double *sorted_fields[PRICE_FIELD_COUNT];
+    column_array(sorted, sorted_fields);
+    for (int i = 0; i < rows; i++)
+    {
+        sorted->timestamps[i] = keys[i].timestamp;
+        for (int f = 0; f < PRICE_FIELD_COUNT; f++)
+            sorted_fields[f][i] = fields[f][keys[i].row];
+    }
+    // swap the storage so `columns` keeps its address
+    int64_t *old_block = columns->timestamps;
+    sorted->fields = columns->fields;
+    *columns = *sorted;
+    sorted->timestamps = old_block;
+    free_price_columns(sorted);
+    free(keys);
+    return SUCCESS;
+}
+
+DLL_EXPORT PriceColumns *parse_price_csv_buffer(const char *data, size_t size, ThreadPool *pool)
+{
+    if (!data && size > 0)
+    {
+        fprintf(stderr, "Invalid input.\n");
+        return NULL;
+    }
+
+    const char *limit = data + size;
+    const char *body = limit;
+    int roles[CSV_MAX_COLUMNS];
+    CsvJob job = {.roles = roles};
+    unsigned fields = 0;
+    if (size > 0)
+    {
+        const char *header = data;
+        if (size >= 3 && memcmp(header, "\xEF\xBB\xBF", 3) == 0) // UTF-8 byte order mark
+            header += 3;
+        const char *header_end = line_end(header, limit, &body);
+        job.needed = parse_header(header, header_end, roles, &job.columns, &fields);
+        if (job.needed < 0)
+        {
+            fprintf(stderr, "Invalid price CSV: no timestamp column.\n");
+            return NULL;
+        }
+    }
+
+    size_t body_size = (size_t)(limit - body);
+    int chunks = 1;
+    if (pool && body_size >= 2 * CSV_MIN_CHUNK_BYTES)
+    {
+        size_t by_size = body_size / CSV_MIN_CHUNK_BYTES;
+        size_t by_workers = (size_t)thread_pool_size(pool) * CSV_CHUNKS_PER_WORKER;
+        chunks = (int)((by_size < by_workers) ? by_size : by_workers);
+    }
+
+    job.bounds = malloc(sizeof(const char *) * (size_t)(chunks + 1));
+    job.rows = malloc(sizeof(int) * (size_t)chunks);
+    job.failed = calloc((size_t)chunks, sizeof(int));
+    PriceColumns *result = NULL;
+    if (!job.bounds || !job.rows || !job.failed)
+    {
+        fprintf(stderr, "Malloc failed. %s.\n", strerror(errno));
+        goto done;
+    }
+
+    // each boundary moves forward to the start of a line; chunks may end up empty
+    job.bounds[0] = body;
+    job.bounds[chunks] = limit;
+    for (int c = 1; c < chunks; c++)
+    {
+        const char *nominal = body + body_size / (size_t)chunks * (size_t)c;
+        if (nominal < job.bounds[c - 1])
+            nominal = job.bounds[c - 1];
+        const char *newline = memchr(nominal, '\n', (size_t)(limit - nominal));
+        job.bounds[c] = newline ? newline + 1 : limit;
+    }
+
+    run_chunks(pool, chunks, count_chunk, &job);
+    long long total = 0;
+    for (int c = 0; c < chunks; c++)
+    {
+        int rows = job.rows[c];
+        job.rows[c] = (int)total;
+        total += rows;
+    }
+    if (total > INT32_MAX)
+    {
+        fprintf(stderr, "Invalid input.\n");
+        goto done;
+    }
+
+    result = alloc_price_columns((int)total);
+    if (!result)
+    {
+        fprintf(stderr, "Malloc failed. %s.\n", strerror(errno));
+        goto done;
+    }
+    result->fields = fields;
+    job.timestamps = result->timestamps;
+    column_array(result, job.fields);
+
+    run_chunks(pool, chunks, parse_chunk, &job);
+    for (int c = 0; c < chunks; c++)
+    {
+        if (job.failed[c])
+        {
+            fprintf(stderr, "Invalid price CSV: malformed row.\n");
+            free_price_columns(result);
+            result = NULL;
+            goto done;
+        }
+    }
+
+    for (int f = 0; f < PRICE_FIELD_COUNT; f++)
+    {
+        if (!(fields & (1u << f)))
+        {
+            for (int i = 0; i < result->rows; i++)
+                job.fields[f][i] = NAN;
+        }
+    }
+    if (sort_rows(result) != SUCCESS)
+    {
+        free_price_columns(result);
+        result = NULL;
+    }
+
+done:
+    free(job.bounds);
+    free(job.rows);
+    free(job.failed);
+    return result;
+}
+
+DLL_EXPORT PriceColumns *parse_price_csv(const char *path, ThreadPool *pool)
+{
+    if (!path)
+    {
+        fprintf(stderr, "Invalid input.\n");
+        return NULL;
+    }
+
+    FILE *f = fopen(path, "rb");
+    if (!f)
+    {
+        fprintf(stderr, "Could not open %s. %s.\n", path, strerror(errno));
+        return NULL;
+    }
+    char *data = NULL;
+    long size = -1;
+    if (fseek(f, 0, SEEK_END) == 0 && (size = ftell(f)) >= 0 && fseek(f, 0, SEEK_SET) == 0)
+    {
+        data = malloc((size_t)size + 1);
+        if (data && fread(data, 1, (size_t)size, f) != (size_t)size)
+        {
+            free(data);
+            data = NULL;
+        }
+    }
+    fclose(f);
+    if (!data)
+    {
+        fprintf(stderr, "Could not read %s. %s.\n", path, strerror(errno));
+        return NULL;
+    }
+
+    PriceColumns *result = parse_price_csv_buffer(data, (size_t)size, pool);
+    free(data);
+    return result;
+}
+
+DLL_EXPORT void free_price_columns(PriceColumns *columns)
+{
+    if (!columns)
+        return;
+    free(columns->timestamps); // start of the column block
+    free(columns);
+}
@@ -0,0 +1,84 @@
+/**
+ * csv_parser.h
+ * ------------
+ * Declarations for the OHLCV CSV parser.
+ *
+ * Parses vendor price history (e.g. the Alpha Vantage TIME_SERIES_DAILY layout) straight
+ * into contiguous columns that can be passed to the indicator functions, or written out
+ * with write_price_file(). Large files are split into chunks that are parsed in parallel
+ * on a thread pool.
+ */
+
+#ifndef CSV_PARSER_H
+#define CSV_PARSER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "indicators.h"
+#include "threadpool.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Price history parsed from a CSV file, oldest bar first.
+ *
+ * The columns share one allocation laid out like the columns of a price file
+ * (timestamps, open, high, low, close, volume), and are NULL when `rows` is 0.
+ */
+typedef struct
+{
+    int rows;
+    unsigned fields; // bit k set if column k of open, high, low, close, volume was in the file; absent columns hold NaN
+    int64_t *timestamps; // seconds since the Unix epoch (UTC), ascending
+    double *open;
+    double *high;
+    double *low;
+    double *close;
+    double *volume;
+} PriceColumns;
+
+/**
+ * @brief Parses an OHLCV CSV held in memory.
+ *
+ * The first line is a header naming the columns, matched case-insensitively: one of
+ * timestamp, date, time or datetime, and any of open, high, low, close and volume. Other
+ * columns are ignored. Each following line is one bar; blank lines are skipped and rows
+ * may come in any order (they are sorted by time, keeping the file order of equal times).
+ *
+ * Timestamps are `YYYY-MM-DD`, optionally followed by ` HH:MM[:SS]` or `THH:MM[:SS]`, or
+ * integer seconds since the Unix epoch. Numbers are parsed without strtod() and give the
+ * same, correctly rounded, values; empty fields are NaN.
+ *
+ * Fields may be enclosed in double quotes, and commas inside quotes do not split a field
+ * (e.g. a quoted note in an ignored column). Quoted fields may not contain line breaks:
+ * every newline ends a row, so such a row is rejected as malformed. Numbers with
+ * thousands separators ("1,234.5") are rejected too.
+ *
+ * @param data Start of the CSV text (it does not need to be NUL-terminated).
+ * @param size Bytes of text.
+ * @param pool Pool to parse large inputs on, or NULL to parse on the calling thread.
+ *
+ * @return Pointer to the parsed columns, or NULL on a missing timestamp column, a
+ *         malformed row or memory allocation failure.
+ *
+ * @note Release the result with free_price_columns().
+ */
+DLL_EXPORT PriceColumns *parse_price_csv_buffer(const char *data, size_t size, ThreadPool *pool);
+
+/**
+ * @brief Reads and parses an OHLCV CSV file. See parse_price_csv_buffer().
+ */
+DLL_EXPORT PriceColumns *parse_price_csv(const char *path, ThreadPool *pool);
+
+/**
+ * @brief Frees the columns and `columns` itself. NULL is ignored.
+ */
+DLL_EXPORT void free_price_columns(PriceColumns *columns);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CSV_PARSER_H
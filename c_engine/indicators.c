@@ -20,6 +20,7 @@
  */
 
 #include "indicators.h"
+#include "simd.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <errno.h>
@@ -31,186 +32,298 @@ DLL_EXPORT void c_free(void *ptr)
     free(ptr);
 }
 
-DLL_EXPORT double *compute_SMA(double *prices, int length, int window)
+/**
+ * Sums `window` consecutive prices starting at `start`, in order.
+ * Used to seed (and periodically resync) the rolling window sums.
+ */
+static double window_sum(const double *start, int window)
 {
-
-    if (!prices || !length || window <= 0 || window >= length)
+    double sum = 0.0;
+    for (int j = 0; j < window; j++)
     {
-        fprintf(stderr, "Invalid input.\n");
-        return NULL;
+        sum += start[j];
     }
+    return sum;
+}
 
-    int result_length = length - window + 1;
-    if (result_length <= 0)
-        return NULL;
+DLL_EXPORT int compute_MACD_output_length(int length, int fast_period, int slow_period, int signal_period)
+{
+    // periods of at least `length` can never fit; rejecting them first keeps the subtraction below from overflowing
+    if (fast_period <= 0 || slow_period <= fast_period || signal_period <= 0 || slow_period >= length ||
+        signal_period >= length)
+        return -1;
+    int result_length = length - slow_period - signal_period + 2; // the first value lines up with prices[slow + signal - 2]
+    return (result_length > 0) ? result_length : -1;
+}
 
-    double *SMA_Values = malloc(sizeof(double) * result_length); // pointer to an array of doubles
-    if (!SMA_Values)
+DLL_EXPORT int compute_output_length(IndicatorType type, int length, int window)
+{
+    switch (type)
     {
-        fprintf(stderr, "Malloc failed. %s.\n", strerror(errno));
-        return NULL;
+    case INDICATOR_SMA:
+    case INDICATOR_EMA:
+    case INDICATOR_BOLLINGER:
+        return (window > 0 && window < length) ? length - window + 1 : -1;
+    case INDICATOR_RSI:
+        return (window > 0 && window < length) ? length - window : -1; // one value per price change after the seed window
+    case INDICATOR_MACD:
+        return compute_MACD_output_length(length, MACD_FAST_PERIOD, MACD_SLOW_PERIOD, MACD_SIGNAL_PERIOD);
+    case INDICATOR_OBV:
+        return (length > 0) ? length : -1;
     }
+    return -1;
+}
 
-    // populate array
+DLL_EXPORT int compute_SMA_into(const double *prices, int length, int window, double *SMA_Values)
+{
+    int result_length = compute_output_length(INDICATOR_SMA, length, window);
+    if (!prices || !SMA_Values || result_length <= 0)
+    {
+        fprintf(stderr, "Invalid input.\n");
+        return FAILURE;
+    }
+    if (rolling_mean_std_simd(prices, result_length, window, 0.0, SMA_Values, NULL, NULL, NULL))
+        return SUCCESS;
+
+    // populate array using a rolling sum: add the price entering the window, drop the one leaving it.
+    // the sum is recomputed exactly every `window` outputs so rounding drift stays bounded,
+    // while the total cost remains O(length) regardless of the window size
+    double sum = 0.0;
     for (int i = 0; i < result_length; i++)
     {
-        double sum = 0.0;
-        for (int j = 0; j < window; j++)
+        if (i % window == 0)
         {
-            sum += prices[i + j];
+            sum = window_sum(prices + i, window);
+        }
+        else
+        {
+            sum += prices[i + window - 1] - prices[i - 1];
         }
         SMA_Values[i] = sum / window;
     }
-    return SMA_Values;
+    return SUCCESS;
 }
 
-DLL_EXPORT double *compute_EMA(double *prices, int length, int window)
+DLL_EXPORT double *compute_SMA(double *prices, int length, int window)
 {
-
-    if (!prices || !length || !window || window >= length)
+    int result_length = compute_output_length(INDICATOR_SMA, length, window);
+    if (!prices || result_length <= 0)
     {
         fprintf(stderr, "Invalid input.\n");
         return NULL;
     }
 
-    int result_length = length - window + 1;
-    if (result_length <= 0)
-        return NULL;
-    double alpha = 2.0 / ((double)window + 1.0);                 // smoothening multiplier
-    double *EMA_Values = malloc(sizeof(double) * result_length); // pointer to an array of doubles
-    double *SMA_Values = compute_SMA(prices, length, window);    // EMA values are based on SMA values with a smoothener applied
-
-    // data validation
-    if (!EMA_Values)
-    {
-        free(SMA_Values);
-        fprintf(stderr, "Malloc failed. %s.\n", strerror(errno));
-        return NULL;
-    }
+    double *SMA_Values = malloc(sizeof(double) * result_length); // pointer to an array of doubles
     if (!SMA_Values)
     {
-        free(EMA_Values);
-        free(SMA_Values);
-        fprintf(stderr, "Get SMA failed. %s.\n", strerror(errno));
+        fprintf(stderr, "Malloc failed. %s.\n", strerror(errno));
         return NULL;
     }
 
-    // populate array
-    EMA_Values[0] = SMA_Values[0]; // first EMA value = seed EMA
+    compute_SMA_into(prices, length, window, SMA_Values);
+    return SMA_Values;
+}
+
+/**
+ * EMA recurrence over `length - window + 1` outputs, seeded with the SMA of the first window.
+ * Performs no validation; callers check their own bounds (window may equal length here).
+ */
+static void ema_kernel(const double *prices, int length, int window, double *EMA_Values)
+{
+    int result_length = length - window + 1;
+    double alpha = 2.0 / ((double)window + 1.0); // smoothening multiplier
+
+    EMA_Values[0] = window_sum(prices, window) / window; // first EMA value = seed EMA (same value as the first SMA)
     for (int i = 1; i < result_length; i++)
     {
         // EMA(current) = ( (Price(current) - EMA(prev) ) x Multiplier) + EMA(prev)
-        EMA_Values[i] = (((double)prices[i + window - 1] - (double)EMA_Values[i - 1]) * alpha) + (double)EMA_Values[i - 1];
+        EMA_Values[i] = ((prices[i + window - 1] - EMA_Values[i - 1]) * alpha) + EMA_Values[i - 1];
     }
-    free(SMA_Values);
-    return EMA_Values;
 }
 
-DLL_EXPORT double *compute_RSI(double *prices, int length, int window)
+DLL_EXPORT int compute_EMA_into(const double *prices, int length, int window, double *EMA_Values)
 {
-    if (!prices || window >= length || window <= 0)
+    int result_length = compute_output_length(INDICATOR_EMA, length, window);
+    if (!prices || !EMA_Values || result_length <= 0)
     {
         fprintf(stderr, "Invalid input.\n");
-        return NULL;
+        return FAILURE;
     }
-    int result_length = length - window + 1;
-    if (result_length <= 0)
-        return NULL;
-    double *RSI_Values = malloc(sizeof(double) * result_length); // pointer to an array of doubles
-    if (!RSI_Values)
+
+    ema_kernel(prices, length, window, EMA_Values);
+    return SUCCESS;
+}
+
+DLL_EXPORT double *compute_EMA(double *prices, int length, int window)
+{
+    int result_length = compute_output_length(INDICATOR_EMA, length, window);
+    if (!prices || result_length <= 0)
     {
-        fprintf(stderr, "Malloc failed. %s.\n", strerror(errno));
+        fprintf(stderr, "Invalid input.\n");
         return NULL;
     }
 
-    // compute price changes
-    double *changes = malloc((length - 1) * sizeof(double)); // changes[0] = prices[1] - prices[0] → change from Day 0 to Day 1
-    double *gains = malloc((length - 1) * sizeof(double));
-    double *losses = malloc((length - 1) * sizeof(double));
-    if (!changes || !gains || !losses)
+    double *EMA_Values = malloc(sizeof(double) * result_length); // pointer to an array of doubles
+    if (!EMA_Values)
     {
-        free(RSI_Values);
-        free(changes);
-        free(gains);
-        free(losses);
-
         fprintf(stderr, "Malloc failed. %s.\n", strerror(errno));
-        exit(EXIT_FAILURE);
+        return NULL;
     }
 
-    for (int i = 1; i < length; i++)
-    {
-        changes[i - 1] = prices[i] - prices[i - 1];
-    }
+    compute_EMA_into(prices, length, window, EMA_Values);
+    return EMA_Values;
+}
 
-    // seperate out gains and losses for first window
+/**
+ * Averages the gains and losses of the first `window` price changes (prices[0..window]).
+ */
+static void rsi_seed(const double *prices, int window, double *avg_gain, double *avg_loss)
+{
     double gain_sum = 0;
     double loss_sum = 0;
-    for (int i = 0; i < window; i++)
+    for (int i = 1; i <= window; i++)
     {
-        if (changes[i] > 0)
-        {
-            gains[i] = changes[i];
-            losses[i] = 0;
-            gain_sum += gains[i];
-        }
-        else if (changes[i] < 0)
-        {
-            losses[i] = -1 * changes[i];
-            gains[i] = 0;
-            loss_sum += losses[i];
-        }
-        else
-        {
-            gains[i] = 0;
-            losses[i] = 0;
-        }
+        double change = prices[i] - prices[i - 1];
+        if (change > 0)
+            gain_sum += change;
+        else if (change < 0)
+            loss_sum += -1 * change;
     }
+    *avg_gain = gain_sum / window;
+    *avg_loss = loss_sum / window;
+}
 
-    // compute average gains / losses over first [window] changes
-    double avg_gain = gain_sum / window;
-    double avg_loss = loss_sum / window;
+/**
+ * Folds one price change into the average gain / loss with Wilder's smoothing.
+ */
+static void rsi_smooth(double *avg_gain, double *avg_loss, double change, int window)
+{
+    double gain = (change > 0) ? change : 0.0;
+    double loss = (change < 0) ? -1 * change : 0.0;
 
-    // calculate first RSI value
-    // this corresponds to the price at prices[window]
-    double RS;
+    // Wilder's smoothening formula: updates weighted average
+    *avg_gain = (*avg_gain * (window - 1) + gain) / window;
+    *avg_loss = (*avg_loss * (window - 1) + loss) / window;
+}
+
+static double rsi_value(double avg_gain, double avg_loss)
+{
     if (avg_loss == 0)
+        return 100;
+    double RS = avg_gain / avg_loss;
+    return 100 - (100 / (1 + RS));
+}
+
+DLL_EXPORT int compute_RSI_into(const double *prices, int length, int window, double *RSI_Values)
+{
+    int result_length = compute_output_length(INDICATOR_RSI, length, window);
+    if (!prices || !RSI_Values || result_length <= 0)
     {
-        RSI_Values[0] = 100;
+        fprintf(stderr, "Invalid input.\n");
+        return FAILURE;
     }
-    else
+
+    // price changes are taken on the fly, so no scratch arrays are needed.
+    // the first RSI value corresponds to the price at prices[window]
+    double avg_gain;
+    double avg_loss;
+    rsi_seed(prices, window, &avg_gain, &avg_loss);
+    RSI_Values[0] = rsi_value(avg_gain, avg_loss);
+
+    // calculate subsquent RSI values
+    for (int i = window + 1; i < length; i++)
     {
-        RS = avg_gain / avg_loss;
-        RSI_Values[0] = 100 - (100 / (1 + RS));
+        rsi_smooth(&avg_gain, &avg_loss, prices[i] - prices[i - 1], window);
+        RSI_Values[i - window] = rsi_value(avg_gain, avg_loss);
     }
+    return SUCCESS;
+}
 
-    // calculate subsquent RSI values
-    double gain;
-    double loss;
-    for (int i = window; i < length - 1; i++)
+DLL_EXPORT double *compute_RSI(double *prices, int length, int window)
+{
+    int result_length = compute_output_length(INDICATOR_RSI, length, window);
+    if (!prices || result_length <= 0)
+    {
+        fprintf(stderr, "Invalid input.\n");
+        return NULL;
+    }
+
+    double *RSI_Values = malloc(sizeof(double) * result_length); // pointer to an array of doubles
+    if (!RSI_Values)
     {
-        gain = (changes[i] > 0) ? changes[i] : 0.0;
-        loss = (changes[i] < 0) ? -1 * changes[i] : 0.0;
+        fprintf(stderr, "Malloc failed. %s.\n", strerror(errno));
+        return NULL;
+    }
 
-        // Wilder's smoothening formula: updates weighted average
-        avg_gain = (avg_gain * (window - 1) + gain) / window;
-        avg_loss = (avg_loss * (window - 1) + loss) / window;
+    if (compute_RSI_into(prices, length, window, RSI_Values) != SUCCESS)
+    {
+        free(RSI_Values);
+        return NULL;
+    }
+    return RSI_Values;
+}
 
-        if (avg_loss == 0)
+/**
+ * Sum of squared deviations from `mean` over `window` consecutive prices.
+ * Used to seed (and periodically resync) the rolling variance.
+ */
+static double window_m2(const double *start, int window, double mean)
+{
+    double m2 = 0.0;
+    for (int j = 0; j < window; j++)
+    {
+        double difference = start[j] - mean;
+        m2 += difference * difference;
+    }
+    return m2;
+}
+
+/**
+ * Single O(n) sweep producing the rolling mean and standard deviation of every window.
+ *
+ * The window sum and the sum of squared deviations (M2) are slid forward with
+ * Welford-style updates and recomputed exactly every `window` outputs, matching the
+ * resync schedule of compute_SMA so `means` is identical to its output.
+ * Any of the output arrays may be NULL; when `top`/`bottom` are given they receive
+ * mean +/- band_width * std_dev. Runs the vectorized kernel from simd.c when one is available.
+ */
+static void rolling_mean_std(const double *prices, int result_length, int window, double band_width,
+                             double *means, double *std_devs, double *top, double *bottom)
+{
+    if (rolling_mean_std_simd(prices, result_length, window, band_width, means, std_devs, top, bottom))
+        return;
+
+    double sum = 0.0;
+    double mean = 0.0;
+    double m2 = 0.0;
+    for (int i = 0; i < result_length; i++)
+    {
+        if (i % window == 0)
         {
-            RSI_Values[i - window + 1] = 100;
+            sum = window_sum(prices + i, window);
+            mean = sum / window;
+            m2 = window_m2(prices + i, window, mean);
         }
         else
         {
-            RS = avg_gain / avg_loss;
-            RSI_Values[i - window + 1] = 100 - (100 / (1 + RS));
+            double x_new = prices[i + window - 1];
+            double x_old = prices[i - 1];
+            double prev_mean = mean;
+            sum += x_new - x_old;
+            mean = sum / window;
+            m2 += (x_new - x_old) * (x_new - mean + x_old - prev_mean);
         }
-    }
 
-    free(changes);
-    free(gains);
-    free(losses);
-    return RSI_Values;
+        double std_dev = (m2 > 0) ? sqrt(m2 / window) : 0.0; // rounding can push M2 slightly below zero
+        if (means)
+            means[i] = mean;
+        if (std_devs)
+            std_devs[i] = std_dev;
+        if (top)
+            top[i] = mean + band_width * std_dev;
+        if (bottom)
+            bottom[i] = mean - band_width * std_dev;
+    }
 }
 
 DLL_EXPORT int compute_std_devs(double *prices, int length, int window, double *means, double *std_devs)
@@ -225,21 +338,37 @@ DLL_EXPORT int compute_std_devs(double *prices, int length, int window, double *
     if (result_length <= 0)
         return EXIT_FAILURE;
 
-    // compute std dev
+    // compute std dev by sliding M2 along with the caller's means, resyncing every `window` outputs
+    double m2 = 0.0;
     for (int i = 0; i < result_length; i++)
     {
-        double sum = 0.0;
-        for (int j = 0; j < window; j++)
+        if (i % window == 0)
+        {
+            m2 = window_m2(prices + i, window, means[i]);
+        }
+        else
         {
-            double difference = prices[i + j] - means[i];
-            sum += difference * difference;
+            double x_new = prices[i + window - 1];
+            double x_old = prices[i - 1];
+            m2 += (x_new - x_old) * (x_new - means[i] + x_old - means[i - 1]);
         }
-        double variance = sum / window;
-        std_devs[i] = sqrt(variance);
+        std_devs[i] = (m2 > 0) ? sqrt(m2 / window) : 0.0;
     }
     return EXIT_SUCCESS;
 }
 
+DLL_EXPORT int compute_rolling_mean_std(double *prices, int length, int window, double *means, double *std_devs)
+{
+    if (!prices || !means || !std_devs || length <= 0 || window <= 0 || window > length)
+    {
+        fprintf(stderr, "Invalid input.\n");
+        return EXIT_FAILURE;
+    }
+
+    rolling_mean_std(prices, length - window + 1, window, 0.0, means, std_devs, NULL, NULL);
+    return EXIT_SUCCESS;
+}
+
 DLL_EXPORT void cleanup_bands(BollingerBands *band_values)
 {
     free(band_values->middle_band);
@@ -248,9 +377,25 @@ DLL_EXPORT void cleanup_bands(BollingerBands *band_values)
     free(band_values);
 }
 
+DLL_EXPORT int compute_bollinger_bands_into(const double *prices, int length, int window, double std_devs,
+                                            double *middle_band, double *top_band, double *bottom_band)
+{
+    int result_length = compute_output_length(INDICATOR_BOLLINGER, length, window);
+    if (!prices || !middle_band || !top_band || !bottom_band || result_length <= 0 || std_devs <= 0)
+    {
+        fprintf(stderr, "Invalid input.\n");
+        return FAILURE;
+    }
+
+    // middle band (SMA), standard deviation and both outer bands in a single pass
+    rolling_mean_std(prices, result_length, window, std_devs, middle_band, NULL, top_band, bottom_band);
+    return SUCCESS;
+}
+
 DLL_EXPORT BollingerBands *compute_bollinger_bands(double *prices, int length, int window, double std_devs)
 {
-    if (!prices || window >= length || window <= 0 || std_devs <= 0)
+    int result_length = compute_output_length(INDICATOR_BOLLINGER, length, window);
+    if (!prices || result_length <= 0 || std_devs <= 0)
     {
         fprintf(stderr, "Invalid input.\n");
         return NULL;
@@ -265,42 +410,89 @@ DLL_EXPORT BollingerBands *compute_bollinger_bands(double *prices, int length, i
     }
 
     // malloc struct fields
-    int result_length = length - window + 1;
-    if (result_length <= 0)
-        return NULL;
-    double *SMA_Values = compute_SMA(prices, length, window); // middle band
     band_values->length = result_length;
-    band_values->middle_band = SMA_Values; // middle_band points to externally-managed memory; do NOT free both band_values->middle_band AND SMA_Values.
-                                           // WILL cause a double free
+    band_values->middle_band = malloc(sizeof(double) * result_length);
     band_values->top_band = malloc(sizeof(double) * result_length);
     band_values->bottom_band = malloc(sizeof(double) * result_length);
-    double *stddev_values = malloc(sizeof(double) * result_length);
-    if (!band_values->top_band || !band_values->bottom_band || !stddev_values)
+    if (!band_values->middle_band || !band_values->top_band || !band_values->bottom_band)
     {
-        free(stddev_values);
         cleanup_bands(band_values);
         fprintf(stderr, "Malloc failed. %s.\n", strerror(errno));
         return NULL;
     }
-    if (!SMA_Values)
+
+    compute_bollinger_bands_into(prices, length, window, std_devs,
+                                 band_values->middle_band, band_values->top_band, band_values->bottom_band);
+    return band_values; // pointer to a BollingerBands struct
+}
+
+struct MACDStream
+{
+    int fast_period;
+    int slow_period;
+    int signal_period;
+    int seen;      // prices consumed so far, saturating once the signal line is seeded
+    double fast_alpha;
+    double slow_alpha;
+    double signal_alpha;
+    double fast_ema; // holds the running seed sum until the fast EMA is seeded
+    double slow_ema; // holds the running seed sum until the slow EMA is seeded
+    double signal_ema; // holds the running seed sum until the signal line is seeded
+    double macd;   // latest MACD value (fast EMA - slow EMA)
+};
+
+/**
+ * Advances every EMA of a MACD stream by one price.
+ * Each EMA is seeded with the plain average of its first `period` inputs, exactly like
+ * ema_kernel(). Shared by the fused batch kernel and the MACD stream so both produce
+ * identical values.
+ *
+ * @return 1 once MACD and signal values are available, 0 while still warming up.
+ */
+static int macd_step(MACDStream *stream, double price)
+{
+    int i = stream->seen;
+    int warmup = stream->slow_period + stream->signal_period - 1;
+    if (i < warmup)
+        stream->seen++;
+
+    if (i < stream->fast_period)
     {
-        free(stddev_values);
-        cleanup_bands(band_values);
-        fprintf(stderr, "Get SMA failed. %s.\n", strerror(errno));
-        return NULL;
+        stream->fast_ema += price;
+        if (i == stream->fast_period - 1)
+            stream->fast_ema /= stream->fast_period;
+    }
+    else
+    {
+        stream->fast_ema = ((price - stream->fast_ema) * stream->fast_alpha) + stream->fast_ema;
     }
 
-    // calculate standard deviation
-    compute_std_devs(prices, length, window, band_values->middle_band, stddev_values);
-
-    for (int i = 0; i < result_length; i++)
+    if (i < stream->slow_period)
+    {
+        stream->slow_ema += price;
+        if (i < stream->slow_period - 1)
+            return 0;
+        stream->slow_ema /= stream->slow_period;
+    }
+    else
     {
-        band_values->top_band[i] = band_values->middle_band[i] + std_devs * stddev_values[i];
-        band_values->bottom_band[i] = band_values->middle_band[i] - std_devs * stddev_values[i];
+        stream->slow_ema = ((price - stream->slow_ema) * stream->slow_alpha) + stream->slow_ema;
     }
 
-    free(stddev_values);
-    return band_values; // pointer to a BollingerBands struct
+    // raw MACD exists from prices[slow_period - 1] onwards; the signal line is an EMA of it
+    stream->macd = stream->fast_ema - stream->slow_ema;
+    if (i < warmup)
+    {
+        stream->signal_ema += stream->macd;
+        if (i < warmup - 1)
+            return 0;
+        stream->signal_ema /= stream->signal_period;
+    }
+    else
+    {
+        stream->signal_ema = ((stream->macd - stream->signal_ema) * stream->signal_alpha) + stream->signal_ema;
+    }
+    return 1;
 }
 
 DLL_EXPORT int cleanup_MACD(MACD *macd)
@@ -310,98 +502,158 @@ DLL_EXPORT int cleanup_MACD(MACD *macd)
         fprintf(stderr, "Null pointer passed.\n");
         return (EXIT_FAILURE);
     }
-    free(macd->MACD_Values);
-    free(macd->signal_line_Values);
-    free(macd);
+    free(macd); // the value arrays live in the same allocation as the struct
     return (EXIT_SUCCESS);
 }
 
-DLL_EXPORT MACD *compute_MACD(double *prices, int length)
+DLL_EXPORT int compute_MACD_periods_into(const double *prices, int length, int fast_period, int slow_period, int signal_period,
+                                         double *MACD_Values, double *signal_line_Values, double *histogram_Values)
 {
     // data verification
-    if (!prices || length - 26 - 9 + 1 <= 0)
+    int result_length = compute_MACD_output_length(length, fast_period, slow_period, signal_period);
+    if (!prices || !MACD_Values || !signal_line_Values || result_length <= 0)
     {
         fprintf(stderr, "Invalid input.\n");
-        return NULL;
+        return FAILURE;
     }
 
-    // mermory management
-    MACD *macd = malloc(sizeof(MACD)); // there is never any need to indivdually free this struct and it's fields.
-                                       // see cleanup_MACD()
-    if (!macd)
+    // one forward pass: fast EMA, slow EMA, MACD line, signal line and histogram together
+    MACDStream state = {0};
+    state.fast_period = fast_period;
+    state.slow_period = slow_period;
+    state.signal_period = signal_period;
+    state.fast_alpha = 2.0 / ((double)fast_period + 1.0);
+    state.slow_alpha = 2.0 / ((double)slow_period + 1.0);
+    state.signal_alpha = 2.0 / ((double)signal_period + 1.0);
+
+    int offset = slow_period + signal_period - 2; // prices index of the first output
+    for (int i = 0; i < offset; i++)
     {
-        fprintf(stderr, "Malloc failed. %s.\n", strerror(errno));
-        return NULL;
+        macd_step(&state, prices[i]);
+    }
+    for (int i = offset; i < length; i++)
+    {
+        macd_step(&state, prices[i]);
+        MACD_Values[i - offset] = state.macd;
+        signal_line_Values[i - offset] = state.signal_ema;
+        if (histogram_Values)
+            histogram_Values[i - offset] = state.macd - state.signal_ema;
     }
+    return SUCCESS;
+}
 
-    int macd_raw_len = length - 26 + 1;      // MACD values from price[25] onwards
-    int result_length = length - 26 - 9 + 1; // usable MACD values after 9-period signal EMA -> price[33] onwards
-    if (result_length <= 0)
-        return NULL;
+DLL_EXPORT int compute_MACD_into(const double *prices, int length, double *MACD_Values, double *signal_line_Values)
+{
+    return compute_MACD_periods_into(prices, length, MACD_FAST_PERIOD, MACD_SLOW_PERIOD, MACD_SIGNAL_PERIOD,
+                                     MACD_Values, signal_line_Values, NULL);
+}
 
-    // calculate EMA of 12 day and 26 day periods
-    double *EMA_12 = compute_EMA(prices, length, 12); // must be freed
-    double *EMA_26 = compute_EMA(prices, length, 26); // must be freed
-    if (!EMA_12 || !EMA_26)
+DLL_EXPORT MACD *compute_MACD_periods(double *prices, int length, int fast_period, int slow_period, int signal_period)
+{
+    // data verification
+    int result_length = compute_MACD_output_length(length, fast_period, slow_period, signal_period);
+    if (!prices || result_length <= 0)
     {
-        free(EMA_12);
-        free(EMA_26);
-        cleanup_MACD(macd);
-        fprintf(stderr, "Compute EMA failed. %s.\n", strerror(errno));
+        fprintf(stderr, "Invalid input.\n");
         return NULL;
     }
 
-    // calculate raw MACD values
-    double *temp_MACDs = malloc(sizeof(double) * (macd_raw_len));
-    if (!temp_MACDs)
+    // mermory management: the struct and its three arrays share a single allocation.
+    // sizeof(MACD) is a multiple of the pointer size, so the arrays that follow stay aligned for doubles
+    MACD *macd = malloc(sizeof(MACD) + sizeof(double) * 3 * (size_t)result_length); // see cleanup_MACD()
+    if (!macd)
     {
-        free(EMA_12);
-        free(EMA_26);
-        cleanup_MACD(macd);
         fprintf(stderr, "Malloc failed. %s.\n", strerror(errno));
         return NULL;
     }
-    for (int i = 0; i < macd_raw_len; i++)
-    {
-        temp_MACDs[i] = EMA_12[i + 14] - EMA_26[i]; // because the windows are different, EMA_12[0] corresponds with
-                                                    // prices[12 -1], whereas EMA_26[0] -> prices[26-1]
-    }
+    macd->length = result_length;
+    macd->MACD_Values = (double *)(macd + 1);
+    macd->signal_line_Values = macd->MACD_Values + result_length;
+    macd->histogram_Values = macd->signal_line_Values + result_length;
+
+    compute_MACD_periods_into(prices, length, fast_period, slow_period, signal_period,
+                              macd->MACD_Values, macd->signal_line_Values, macd->histogram_Values);
+    return macd;
+}
 
-    // compute signal values
-    macd->signal_line_Values = compute_EMA(temp_MACDs, macd_raw_len, 9);
-    if (!macd->signal_line_Values)
+DLL_EXPORT MACD *compute_MACD(double *prices, int length)
+{
+    return compute_MACD_periods(prices, length, MACD_FAST_PERIOD, MACD_SLOW_PERIOD, MACD_SIGNAL_PERIOD);
+}
+
+DLL_EXPORT int compute_OBV_into(const double *prices, const double *volumes, int length, double *OBV_values)
+{
+    if (!prices || !volumes || !OBV_values || compute_output_length(INDICATOR_OBV, length, 0) <= 0)
     {
-        free(temp_MACDs);
-        free(EMA_12);
-        free(EMA_26);
-        cleanup_MACD(macd);
-        fprintf(stderr, "Compute EMA failed. %s.\n", strerror(errno));
-        return NULL;
+        fprintf(stderr, "Invalid input.\n");
+        return FAILURE;
     }
 
-    // populate struct with refined macd values
-    macd->MACD_Values = malloc(sizeof(double) * result_length);
-    if (!macd->MACD_Values)
+    // populate array
+    OBV_values[0] = 0.0;
+    for (int i = 1; i < length; i++)
     {
-        free(temp_MACDs);
-        free(EMA_12);
-        free(EMA_26);
-        cleanup_MACD(macd);
-        fprintf(stderr, "Malloc failed. %s.\n", strerror(errno));
-        return NULL;
+        double change = prices[i] - prices[i - 1];
+        if (change > 0)
+        {
+            OBV_values[i] = OBV_values[i - 1] + volumes[i];
+        }
+        else if (change < 0)
+        {
+            OBV_values[i] = OBV_values[i - 1] - volumes[i];
+        }
+        else
+        {
+            OBV_values[i] = OBV_values[i - 1];
+        }
     }
-    for (int i = 0; i < result_length; i++)
+    return SUCCESS;
+}
+
+DLL_EXPORT int compute_RSI_OBV_into(const double *prices, const double *volumes, int length, int window,
+                                    double *RSI_Values, double *OBV_values)
+{
+    if (!prices || !volumes || !RSI_Values || !OBV_values || compute_output_length(INDICATOR_RSI, length, window) <= 0)
     {
-        macd->MACD_Values[i] = temp_MACDs[i + 8];
+        fprintf(stderr, "Invalid input.\n");
+        return FAILURE;
     }
 
-    // assign final length
-    macd->length = result_length;
+    // one sweep over the price changes: the OBV step, then the RSI seed sums or smoothing step,
+    // each with the same operations as compute_OBV_into / compute_RSI_into
+    double gain_sum = 0;
+    double loss_sum = 0;
+    double avg_gain = 0.0;
+    double avg_loss = 0.0;
+    OBV_values[0] = 0.0;
+    for (int i = 1; i < length; i++)
+    {
+        double change = prices[i] - prices[i - 1];
+        if (change > 0)
+            OBV_values[i] = OBV_values[i - 1] + volumes[i];
+        else if (change < 0)
+            OBV_values[i] = OBV_values[i - 1] - volumes[i];
+        else
+            OBV_values[i] = OBV_values[i - 1];
 
-    free(temp_MACDs);
-    free(EMA_12);
-    free(EMA_26);
-    return macd;
+        if (i <= window)
+        {
+            if (change > 0)
+                gain_sum += change;
+            else if (change < 0)
+                loss_sum += -1 * change;
+            if (i < window)
+                continue;
+            avg_gain = gain_sum / window;
+            avg_loss = loss_sum / window;
+        }
+        else
+        {
+            rsi_smooth(&avg_gain, &avg_loss, change, window);
+        }
+        RSI_Values[i - window] = rsi_value(avg_gain, avg_loss);
+    }
+    return SUCCESS;
 }
 
 DLL_EXPORT double *compute_OBV(const double *prices, const double *volumes, int length)
@@ -419,29 +671,397 @@ DLL_EXPORT double *compute_OBV(const double *prices, const double *volumes, int
         return NULL;
     }
 
-    // populate array
-    OBV_values[0] = 0.0;
-    for (int i = 1; i < length; i++)
+    compute_OBV_into(prices, volumes, length, OBV_values);
+    return OBV_values;
+}
+
+/*
+ * Streaming state
+ * ---------------
+ * Each stream is seeded by running the batch arithmetic over a warm-up history, then keeps
+ * only the state needed to produce the next value. Updates perform the exact same floating
+ * point operations as the batch functions, so a stream yields bit-identical results to
+ * recomputing the whole series.
+ */
+
+struct SMAStream
+{
+    int window;
+    int head;     // index in `ring` of the oldest price in the window
+    int phase;    // output index modulo window; the sum is resynced exactly when it wraps to 0
+    double sum;   // rolling sum of the window
+    double ring[]; // last `window` prices
+};
+
+DLL_EXPORT SMAStream *init_SMA_stream(const double *history, int length, int window)
+{
+    if (!history || window <= 0 || length < window)
     {
-        double change = prices[i] - prices[i - 1];
-        if (change > 0)
+        fprintf(stderr, "Invalid input.\n");
+        return NULL;
+    }
+
+    SMAStream *stream = malloc(sizeof(SMAStream) + sizeof(double) * window);
+    if (!stream)
+    {
+        fprintf(stderr, "Malloc failed. %s.\n", strerror(errno));
+        return NULL;
+    }
+
+    // replay compute_SMA_into's rolling sum over the history so the resync schedule lines up
+    int result_length = length - window + 1;
+    double sum = 0.0;
+    for (int i = 0; i < result_length; i++)
+    {
+        if (i % window == 0)
         {
-            OBV_values[i] = OBV_values[i - 1] + volumes[i];
+            sum = window_sum(history + i, window);
         }
-        else if (change < 0)
+        else
         {
-            OBV_values[i] = OBV_values[i - 1] - volumes[i];
+            sum += history[i + window - 1] - history[i - 1];
         }
-        else
+    }
+
+    stream->window = window;
+    stream->head = 0;
+    stream->phase = result_length % window;
+    stream->sum = sum;
+    memcpy(stream->ring, history + length - window, sizeof(double) * window);
+    return stream;
+}
+
+DLL_EXPORT double update_SMA_stream(SMAStream *stream, double price)
+{
+    if (!stream)
+        return NAN;
+
+    int window = stream->window;
+    double oldest = stream->ring[stream->head];
+    stream->ring[stream->head] = price;
+    stream->head = (stream->head + 1 == window) ? 0 : stream->head + 1;
+
+    if (stream->phase == 0)
+    {
+        // exact resync, summing oldest to newest like window_sum()
+        double sum = 0.0;
+        for (int j = stream->head; j < window; j++)
         {
-            OBV_values[i] = OBV_values[i - 1];
+            sum += stream->ring[j];
         }
+        for (int j = 0; j < stream->head; j++)
+        {
+            sum += stream->ring[j];
+        }
+        stream->sum = sum;
+    }
+    else
+    {
+        stream->sum += price - oldest;
     }
+    stream->phase = (stream->phase + 1 == window) ? 0 : stream->phase + 1;
 
-    return OBV_values;
+    return stream->sum / window;
 }
 
-int main(void) // needed for compliation
+DLL_EXPORT double get_SMA_stream_value(const SMAStream *stream)
+{
+    return stream ? stream->sum / stream->window : NAN;
+}
+
+/**
+ * Validates the arguments shared by the append_*_stream functions.
+ */
+static int invalid_append(const void *stream, const double *prices, int count, const double *out)
 {
+    if (!stream || count < 0 || (count > 0 && (!prices || !out)))
+    {
+        fprintf(stderr, "Invalid input.\n");
+        return 1;
+    }
     return 0;
-}
\ No newline at end of file
+}
+
+DLL_EXPORT int append_SMA_stream(SMAStream *stream, const double *prices, int count, double *SMA_Values)
+{
+    if (invalid_append(stream, prices, count, SMA_Values))
+        return FAILURE;
+    for (int i = 0; i < count; i++)
+    {
+        SMA_Values[i] = update_SMA_stream(stream, prices[i]);
+    }
+    return SUCCESS;
+}
+
+DLL_EXPORT void cleanup_SMA_stream(SMAStream *stream)
+{
+    free(stream);
+}
+
+struct EMAStream
+{
+    double alpha; // smoothening multiplier
+    double ema;   // latest EMA value
+};
+
+DLL_EXPORT EMAStream *init_EMA_stream(const double *history, int length, int window)
+{
+    if (!history || window <= 0 || length < window)
+    {
+        fprintf(stderr, "Invalid input.\n");
+        return NULL;
+    }
+
+    EMAStream *stream = malloc(sizeof(EMAStream));
+    if (!stream)
+    {
+        fprintf(stderr, "Malloc failed. %s.\n", strerror(errno));
+        return NULL;
+    }
+
+    stream->alpha = 2.0 / ((double)window + 1.0);
+    stream->ema = window_sum(history, window) / window; // seed EMA, as in ema_kernel()
+    for (int i = window; i < length; i++)
+    {
+        stream->ema = ((history[i] - stream->ema) * stream->alpha) + stream->ema;
+    }
+    return stream;
+}
+
+DLL_EXPORT double update_EMA_stream(EMAStream *stream, double price)
+{
+    if (!stream)
+        return NAN;
+
+    // EMA(current) = ( (Price(current) - EMA(prev) ) x Multiplier) + EMA(prev)
+    stream->ema = ((price - stream->ema) * stream->alpha) + stream->ema;
+    return stream->ema;
+}
+
+DLL_EXPORT double get_EMA_stream_value(const EMAStream *stream)
+{
+    return stream ? stream->ema : NAN;
+}
+
+DLL_EXPORT int append_EMA_stream(EMAStream *stream, const double *prices, int count, double *EMA_Values)
+{
+    if (invalid_append(stream, prices, count, EMA_Values))
+        return FAILURE;
+    double ema = stream->ema; // kept in a register across the block
+    for (int i = 0; i < count; i++)
+    {
+        ema = ((prices[i] - ema) * stream->alpha) + ema;
+        EMA_Values[i] = ema;
+    }
+    stream->ema = ema;
+    return SUCCESS;
+}
+
+DLL_EXPORT void cleanup_EMA_stream(EMAStream *stream)
+{
+    free(stream);
+}
+
+struct RSIStream
+{
+    int window;
+    double last_price;
+    double avg_gain;
+    double avg_loss;
+};
+
+DLL_EXPORT RSIStream *init_RSI_stream(const double *history, int length, int window)
+{
+    if (!history || window <= 0 || length < window + 1)
+    {
+        fprintf(stderr, "Invalid input.\n");
+        return NULL;
+    }
+
+    RSIStream *stream = malloc(sizeof(RSIStream));
+    if (!stream)
+    {
+        fprintf(stderr, "Malloc failed. %s.\n", strerror(errno));
+        return NULL;
+    }
+
+    stream->window = window;
+    stream->last_price = history[window];
+    rsi_seed(history, window, &stream->avg_gain, &stream->avg_loss);
+
+    for (int i = window + 1; i < length; i++)
+    {
+        update_RSI_stream(stream, history[i]);
+    }
+    return stream;
+}
+
+DLL_EXPORT double update_RSI_stream(RSIStream *stream, double price)
+{
+    if (!stream)
+        return NAN;
+
+    rsi_smooth(&stream->avg_gain, &stream->avg_loss, price - stream->last_price, stream->window);
+    stream->last_price = price;
+    return rsi_value(stream->avg_gain, stream->avg_loss);
+}
+
+DLL_EXPORT double get_RSI_stream_value(const RSIStream *stream)
+{
+    return stream ? rsi_value(stream->avg_gain, stream->avg_loss) : NAN;
+}
+
+DLL_EXPORT int append_RSI_stream(RSIStream *stream, const double *prices, int count, double *RSI_Values)
+{
+    if (invalid_append(stream, prices, count, RSI_Values))
+        return FAILURE;
+    for (int i = 0; i < count; i++)
+    {
+        RSI_Values[i] = update_RSI_stream(stream, prices[i]);
+    }
+    return SUCCESS;
+}
+
+DLL_EXPORT void cleanup_RSI_stream(RSIStream *stream)
+{
+    free(stream);
+}
+
+DLL_EXPORT MACDStream *init_MACD_stream(const double *history, int length, int fast_period, int slow_period, int signal_period)
+{
+    if (!history || compute_MACD_output_length(length, fast_period, slow_period, signal_period) <= 0)
+    {
+        fprintf(stderr, "Invalid input.\n");
+        return NULL;
+    }
+
+    MACDStream *stream = calloc(1, sizeof(MACDStream)); // seed sums start at zero
+    if (!stream)
+    {
+        fprintf(stderr, "Malloc failed. %s.\n", strerror(errno));
+        return NULL;
+    }
+
+    stream->fast_period = fast_period;
+    stream->slow_period = slow_period;
+    stream->signal_period = signal_period;
+    stream->fast_alpha = 2.0 / ((double)fast_period + 1.0);
+    stream->slow_alpha = 2.0 / ((double)slow_period + 1.0);
+    stream->signal_alpha = 2.0 / ((double)signal_period + 1.0);
+    for (int i = 0; i < length; i++)
+    {
+        macd_step(stream, history[i]);
+    }
+    return stream;
+}
+
+DLL_EXPORT int get_MACD_stream_point(const MACDStream *stream, MACDPoint *point)
+{
+    if (!stream || !point)
+    {
+        fprintf(stderr, "Null pointer passed.\n");
+        return FAILURE;
+    }
+    point->MACD_Value = stream->macd;
+    point->signal_line_Value = stream->signal_ema;
+    point->histogram_Value = stream->macd - stream->signal_ema;
+    return SUCCESS;
+}
+
+DLL_EXPORT int update_MACD_stream(MACDStream *stream, double price, MACDPoint *point)
+{
+    if (!stream || !point)
+    {
+        fprintf(stderr, "Null pointer passed.\n");
+        return FAILURE;
+    }
+    macd_step(stream, price); // always ready: init requires a full warm-up history
+    return get_MACD_stream_point(stream, point);
+}
+
+DLL_EXPORT int append_MACD_stream(MACDStream *stream, const double *prices, int count, double *MACD_Values,
+                                  double *signal_line_Values, double *histogram_Values)
+{
+    if (invalid_append(stream, prices, count, MACD_Values) || (count > 0 && !signal_line_Values))
+        return FAILURE;
+    for (int i = 0; i < count; i++)
+    {
+        macd_step(stream, prices[i]);
+        MACD_Values[i] = stream->macd;
+        signal_line_Values[i] = stream->signal_ema;
+        if (histogram_Values)
+            histogram_Values[i] = stream->macd - stream->signal_ema;
+    }
+    return SUCCESS;
+}
+
+DLL_EXPORT void cleanup_MACD_stream(MACDStream *stream)
+{
+    free(stream);
+}
+
+struct OBVStream
+{
+    double last_price;
+    double obv; // latest OBV value
+};
+
+DLL_EXPORT OBVStream *init_OBV_stream(const double *prices, const double *volumes, int length)
+{
+    if (!prices || !volumes || length < 1)
+    {
+        fprintf(stderr, "Invalid input.\n");
+        return NULL;
+    }
+
+    OBVStream *stream = malloc(sizeof(OBVStream));
+    if (!stream)
+    {
+        fprintf(stderr, "Malloc failed. %s.\n", strerror(errno));
+        return NULL;
+    }
+
+    stream->last_price = prices[0];
+    stream->obv = 0.0; // as in compute_OBV_into
+    for (int i = 1; i < length; i++)
+    {
+        update_OBV_stream(stream, prices[i], volumes[i]);
+    }
+    return stream;
+}
+
+DLL_EXPORT double update_OBV_stream(OBVStream *stream, double price, double volume)
+{
+    if (!stream)
+        return NAN;
+
+    double change = price - stream->last_price;
+    if (change > 0)
+        stream->obv = stream->obv + volume;
+    else if (change < 0)
+        stream->obv = stream->obv - volume;
+    stream->last_price = price;
+    return stream->obv;
+}
+
+DLL_EXPORT double get_OBV_stream_value(const OBVStream *stream)
+{
+    return stream ? stream->obv : NAN;
+}
+
+DLL_EXPORT int append_OBV_stream(OBVStream *stream, const double *prices, const double *volumes, int count,
+                                 double *OBV_values)
+{
+    if (invalid_append(stream, prices, count, OBV_values) || (count > 0 && !volumes))
+        return FAILURE;
+    for (int i = 0; i < count; i++)
+    {
+        OBV_values[i] = update_OBV_stream(stream, prices[i], volumes[i]);
+    }
+    return SUCCESS;
+}
+
+DLL_EXPORT void cleanup_OBV_stream(OBVStream *stream)
+{
+    free(stream);
+}
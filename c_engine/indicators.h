@@ -5,6 +5,9 @@
  * for use in a high-performance stock analysis API.
  */
 
+#ifndef INDICATORS_H
+#define INDICATORS_H
+
 #define DEFAULT_WINDOW_SIZE 20
 #define SUCCESS 0
 #define FAILURE 1
@@ -14,6 +17,10 @@
 #define DLL_EXPORT
 #endif
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /**
  * @brief Frees memory allocated on the heap.
  *
@@ -29,12 +36,116 @@
  */
 DLL_EXPORT void c_free(void *ptr);
 
+/**
+ * @brief Identifies an indicator when querying output sizes.
+ */
+typedef enum
+{
+    INDICATOR_SMA,
+    INDICATOR_EMA,
+    INDICATOR_RSI,
+    INDICATOR_BOLLINGER,
+    INDICATOR_MACD,
+    INDICATOR_OBV
+} IndicatorType;
+
+/**
+ * @brief Reports how many values an indicator produces for a price series.
+ *
+ * Use this to size caller-owned buffers for the `_into` variants. For Bollinger Bands
+ * and MACD the value is the length of each individual output array.
+ *
+ * @param type   The indicator to size.
+ * @param length Total number of prices in the input series.
+ * @param window Lookback period; ignored for MACD and OBV.
+ *
+ * @return The number of output values, or -1 if the parameters are invalid for the indicator.
+ */
+DLL_EXPORT int compute_output_length(IndicatorType type, int length, int window);
+
+/**
+ * @brief Reports how many values a MACD with custom periods produces.
+ *
+ * @return `length - slow_period - signal_period + 2`, or -1 if the periods are invalid
+ *         (they must satisfy 0 < fast_period < slow_period and signal_period > 0)
+ *         or the series is too short.
+ */
+DLL_EXPORT int compute_MACD_output_length(int length, int fast_period, int slow_period, int signal_period);
+
+/**
+ * @brief Instruction sets the rolling window kernels (SMA, Bollinger Bands, rolling
+ *        mean / standard deviation) can run on.
+ */
+typedef enum
+{
+    SIMD_SCALAR,
+    SIMD_AVX2,
+    SIMD_AVX512
+} SimdLevel;
+
+/**
+ * @brief Relative difference allowed between vectorized and scalar rolling window results.
+ *
+ * The vectorized rolling kernels (see set_rolling_simd()) keep the exact resync every
+ * `window` outputs but add the values in a different order in between, so results agree
+ * with the scalar kernels to within this factor of the price magnitude rather than bit
+ * for bit.
+ */
+#define SIMD_RELATIVE_TOLERANCE 1e-12
+
+/**
+ * @brief Reports the SIMD level the vectorized kernels currently use: the widest level
+ *        supported by the CPU, capped by set_simd_level().
+ *
+ * The multi-symbol (interleaved) kernels give the same bits at every level. The rolling
+ * window kernels of SMA, Bollinger Bands and compute_rolling_mean_std use it unless
+ * disabled with set_rolling_simd().
+ */
+DLL_EXPORT int get_simd_level(void);
+
+/**
+ * @brief Caps the SIMD level used by the vectorized kernels.
+ *
+ * @param level One of SimdLevel; SIMD_SCALAR disables vectorization. Values out of range
+ *              are clamped.
+ *
+ * @return The level now in effect, which may be lower than requested on older CPUs.
+ *
+ * @note The setting is process-wide and is meant to be changed at startup or in tests.
+ */
+DLL_EXPORT int set_simd_level(int level);
+
+/**
+ * @brief Enables or disables the vectorized rolling window kernels for SMA, Bollinger
+ *        Bands and compute_rolling_mean_std (windows of 16 or more).
+ *
+ * On by default, dispatched on the SIMD level detected with CPUID: these functions are
+ * faster on long windows but only agree with the streaming API within
+ * SIMD_RELATIVE_TOLERANCE. Disabled, the scalar kernels give exactly the values of the
+ * streams, for callers that need a result not to depend on whether it was computed in
+ * batch or extended bar by bar.
+ *
+ * @param enabled Nonzero to enable, zero to use the scalar kernels.
+ *
+ * @return The previous setting.
+ *
+ * @note The setting is process-wide and is meant to be changed at startup or in tests.
+ */
+DLL_EXPORT int set_rolling_simd(int enabled);
+
+/**
+ * @brief Reports whether the vectorized rolling window kernels are enabled.
+ */
+DLL_EXPORT int get_rolling_simd(void);
+
 /**
  * @brief Computes the Simple Moving Average (SMA) of a price series.
  *
  * This function calculates the SMA over a sliding window of the given size.
  * It returns a dynamically allocated array of SMA values, where each element
  * corresponds to the average of `window` consecutive prices.
+ * The window sum is updated incrementally (and recomputed exactly every `window`
+ * outputs to bound rounding drift), so the cost is O(length) for any window size.
  *
  * An SMA is a type of moving average (MA). Moving averages are calculated to
  * identify the trend direction of a stock.
@@ -58,6 +169,18 @@ DLL_EXPORT void c_free(void *ptr);
  */
 DLL_EXPORT double *compute_SMA(double *prices, int length, int window);
 
+/**
+ * @brief Computes the SMA into a caller-supplied buffer.
+ *
+ * Same values as compute_SMA, without allocating.
+ *
+ * @param SMA_Values Pointer to a buffer of at least
+ *                   compute_output_length(INDICATOR_SMA, length, window) doubles.
+ *
+ * @return SUCCESS, or FAILURE if input parameters are invalid.
+ */
+DLL_EXPORT int compute_SMA_into(const double *prices, int length, int window, double *SMA_Values);
+
 /**
  * @brief Computes the Exponential Moving Average (EMA) of a price series.
  *
@@ -86,19 +209,32 @@ DLL_EXPORT double *compute_SMA(double *prices, int length, int window);
  */
 DLL_EXPORT double *compute_EMA(double *prices, int length, int window);
 
+/**
+ * @brief Computes the EMA into a caller-supplied buffer.
+ *
+ * Same values as compute_EMA, without allocating.
+ *
+ * @param EMA_Values Pointer to a buffer of at least
+ *                   compute_output_length(INDICATOR_EMA, length, window) doubles.
+ *
+ * @return SUCCESS, or FAILURE if input parameters are invalid.
+ */
+DLL_EXPORT int compute_EMA_into(const double *prices, int length, int window, double *EMA_Values);
+
 /**
  * @brief Computes the Relative Strength Index (RSI) of a price series.
  *
  * The RSI is a momentum oscillator that measures the speed and magnitude of
  * recent price changes to identify overbought or oversold conditions.
  * It is calculated using Wilder's smoothing method over a given window size.
+ * Price changes are computed on the fly, so the only allocation is the result array.
  *
  * @param prices Pointer to an array of double-precision prices.
  * @param length Total number of price entries in the array.
  * @param window Lookback period over which RSI is calculated (typically 14).
  *
  * @return Pointer to a dynamically allocated array of RSI values.
- *         The array has length (length - window + 1), corresponding to
+ *         The array has length (length - window), corresponding to
  *         RSI values for prices[window] to prices[length - 1].
  *         Returns NULL if input is invalid or memory allocation fails.
  *
@@ -106,11 +242,25 @@ DLL_EXPORT double *compute_EMA(double *prices, int length, int window);
  */
 DLL_EXPORT double *compute_RSI(double *prices, int length, int window);
 
+/**
+ * @brief Computes the RSI into a caller-supplied buffer.
+ *
+ * Same values as compute_RSI, without allocating any memory.
+ *
+ * @param RSI_Values Pointer to a buffer of at least
+ *                   compute_output_length(INDICATOR_RSI, length, window) doubles.
+ *
+ * @return SUCCESS, or FAILURE if input parameters are invalid.
+ */
+DLL_EXPORT int compute_RSI_into(const double *prices, int length, int window, double *RSI_Values);
+
 /**
  * @brief Computes the standard deviation of a price series over a sliding window.
  *
  * This function calculates the standard deviation of the price values within each
  * window of size `window`. It stores the results in the pre-allocated `std_devs` array.
+ * The squared deviations are slid from one window to the next rather than re-walked,
+ * so the cost is O(length) for any window size.
  *
  * The length of the `std_devs` array should be `length - window + 1`.
  *
@@ -126,6 +276,27 @@ DLL_EXPORT double *compute_RSI(double *prices, int length, int window);
  */
 DLL_EXPORT int compute_std_devs(double *prices, int length, int window, double *means, double *std_devs);
 
+/**
+ * @brief Computes the rolling mean and standard deviation of a price series in one pass.
+ *
+ * Equivalent to compute_SMA followed by compute_std_devs, but both statistics are
+ * produced by a single O(length) sweep using a Welford-style sliding update.
+ * The means are identical to the values returned by compute_SMA.
+ *
+ * @param prices    Pointer to an array of double representing the price series.
+ * @param length    The total number of prices in the `prices` array.
+ * @param window    The size of the moving window (number of periods).
+ * @param means     Pointer to a pre-allocated array that receives the mean of each window.
+ *                  Length is `length - window + 1`.
+ * @param std_devs  Pointer to a pre-allocated array that receives the standard deviation
+ *                  of each window. Length is `length - window + 1`.
+ *
+ * @return EXIT_SUCCESS on success, EXIT_FAILURE on invalid input.
+ *
+ * @note The caller is responsible for allocating and freeing both arrays.
+ */
+DLL_EXPORT int compute_rolling_mean_std(double *prices, int length, int window, double *means, double *std_devs);
+
 typedef struct
 {
     double *middle_band;
@@ -156,6 +327,9 @@ DLL_EXPORT void cleanup_bands(BollingerBands *band_values);
  * The upper and lower bands are typically two standard deviations above or below a 20-period simple moving average (SMA).
  * The bands widen and narrow as the volatility of the underlying asset changes.
  *
+ * The middle, top and bottom bands are written in a single O(length) pass without any
+ * intermediate standard deviation buffer.
+ *
  * @param prices Pointer to an array of double-precision prices.
  * @param length Total number of price entries in the array.
  * @param window Lookback period over which bands are calculated (typically 20).
@@ -174,23 +348,40 @@ DLL_EXPORT void cleanup_bands(BollingerBands *band_values);
  */
 DLL_EXPORT BollingerBands *compute_bollinger_bands(double *prices, int length, int window, double std_devs);
 
+/**
+ * @brief Computes the Bollinger Bands into caller-supplied buffers.
+ *
+ * Same values as compute_bollinger_bands, without allocating. Each band buffer must hold
+ * at least compute_output_length(INDICATOR_BOLLINGER, length, window) doubles.
+ *
+ * @return SUCCESS, or FAILURE if input parameters are invalid.
+ */
+DLL_EXPORT int compute_bollinger_bands_into(const double *prices, int length, int window, double std_devs,
+                                            double *middle_band, double *top_band, double *bottom_band);
+
+#define MACD_FAST_PERIOD 12
+#define MACD_SLOW_PERIOD 26
+#define MACD_SIGNAL_PERIOD 9
+
 typedef struct
 {
     int length;
     double *MACD_Values;
     double *signal_line_Values;
+    double *histogram_Values; // MACD_Values - signal_line_Values
 } MACD;
 
 /**
  * @brief Frees memory allocated for a MACD struct and its fields.
  *
- * This function frees the dynamically allocated arrays for the MACD_Values
- * and signal_line_Values inside the given `MACD` struct,
- * and then frees the struct itself.
+ * The MACD_Values, signal_line_Values and histogram_Values arrays are allocated
+ * together with the struct, so this releases all of them at once.
  *
- * @param band_values Pointer to the dynamically allocated BollingerBands struct to clean up.
+ * @param macd Pointer to a MACD struct returned by compute_MACD() or compute_MACD_periods().
  *
- * @note After calling this function, the pointer `band_values` becomes invalid.
+ * @return EXIT_SUCCESS (0), or EXIT_FAILURE (1) if `macd` is NULL.
+ *
+ * @note After calling this function, the pointer `macd` becomes invalid.
  *       Do not use it after cleanup.
  */
 DLL_EXPORT int cleanup_MACD(MACD *macd);
@@ -203,7 +394,9 @@ DLL_EXPORT int cleanup_MACD(MACD *macd);
  * Exponential Moving Averages (EMAs). The signal line is a 9-period EMA of the MACD line.
  *
  * The result is returned as a pointer to a dynamically allocated `MACD` struct, which
- * contains both arrays and their length. This technical indicator is commonly used
+ * contains the MACD, signal line and histogram arrays and their length. All values are
+ * produced by a single forward pass over the prices, and the struct and its arrays share
+ * one allocation. This technical indicator is commonly used
  * to assess momentum and potential trend reversals in financial data.
  *
  * The first MACD/signal values correspond with the price[33].
@@ -214,14 +407,54 @@ DLL_EXPORT int cleanup_MACD(MACD *macd);
  * @return Pointer to a dynamically allocated `MACD` struct containing:
  *         - `MACD_Values`: an array of MACD values
  *         - `signal_line_Values`: an array of signal line values
- *         - `length`: the number of valid MACD/signal values (equal to `length - 26 - 9 + 1`).
+ *         - `histogram_Values`: an array of MACD minus signal line values
+ *         - `length`: the number of valid MACD/signal values (equal to `length - 26 - 9 + 2`,
+ *           so the last values correspond with the last price).
  *         Returns NULL on invalid input or memory allocation failure.
  *
- * @note Caller is responsible for freeing all dynamically allocated memory,
- *       including the arrays and the struct itself.
+ * @note Caller is responsible for freeing the result with cleanup_MACD().
  */
 DLL_EXPORT MACD *compute_MACD(double *prices, int length);
 
+/**
+ * @brief Computes the MACD with custom EMA periods.
+ *
+ * Same as compute_MACD, with the fast, slow and signal periods supplied by the caller.
+ * The result holds `length - slow_period - signal_period + 2` values, the first of which
+ * corresponds with prices[slow_period + signal_period - 2].
+ *
+ * @param fast_period   Period of the fast EMA (typically 12).
+ * @param slow_period   Period of the slow EMA (typically 26); must be greater than `fast_period`.
+ * @param signal_period Period of the signal line EMA (typically 9).
+ *
+ * @return Pointer to a dynamically allocated `MACD` struct, or NULL on invalid input or
+ *         memory allocation failure. Free it with cleanup_MACD().
+ */
+DLL_EXPORT MACD *compute_MACD_periods(double *prices, int length, int fast_period, int slow_period, int signal_period);
+
+/**
+ * @brief Computes the MACD and signal line into caller-supplied buffers.
+ *
+ * Same values as compute_MACD. Both buffers must hold at least
+ * compute_output_length(INDICATOR_MACD, length, 0) doubles.
+ *
+ * @return SUCCESS, or FAILURE if input parameters are invalid.
+ */
+DLL_EXPORT int compute_MACD_into(const double *prices, int length, double *MACD_Values, double *signal_line_Values);
+
+/**
+ * @brief Computes the MACD with custom periods into caller-supplied buffers.
+ *
+ * Single forward pass with no scratch memory. Each buffer must hold at least
+ * `length - slow_period - signal_period + 2` doubles.
+ *
+ * @param histogram_Values Receives MACD minus signal line; may be NULL if not needed.
+ *
+ * @return SUCCESS, or FAILURE if input parameters are invalid.
+ */
+DLL_EXPORT int compute_MACD_periods_into(const double *prices, int length, int fast_period, int slow_period, int signal_period,
+                                         double *MACD_Values, double *signal_line_Values, double *histogram_Values);
+
 /**
  * @brief Computes the On-Balance Volume (OBV) indicator from a price and volume series.
  *
@@ -243,3 +476,275 @@ DLL_EXPORT MACD *compute_MACD(double *prices, int length);
  * @note Caller is responsible for freeing the returned OBV array.
  */
 DLL_EXPORT double *compute_OBV(const double *prices, const double *volumes, int length);
+
+/**
+ * @brief Computes the OBV into a caller-supplied buffer of at least `length` doubles.
+ *
+ * Same values as compute_OBV, without allocating.
+ *
+ * @return SUCCESS, or FAILURE if input parameters are invalid.
+ */
+DLL_EXPORT int compute_OBV_into(const double *prices, const double *volumes, int length, double *OBV_values);
+
+/**
+ * @brief Computes the RSI and the OBV of one series in a single pass over its price changes.
+ *
+ * Each price change is taken once and feeds both Wilder's smoothing and the OBV
+ * accumulation, so the prices are read once instead of twice. The values are identical
+ * to compute_RSI_into and compute_OBV_into.
+ *
+ * @param RSI_Values Buffer of at least compute_output_length(INDICATOR_RSI, length, window) doubles.
+ * @param OBV_values Buffer of at least `length` doubles.
+ *
+ * @return SUCCESS, or FAILURE if input parameters are invalid.
+ */
+DLL_EXPORT int compute_RSI_OBV_into(const double *prices, const double *volumes, int length, int window,
+                                    double *RSI_Values, double *OBV_values);
+
+
+/*
+ * Streaming indicators
+ * --------------------
+ * A stream is seeded from a warm-up history and then advanced one price at a time.
+ * Every update is O(1) (the SMA resyncs its window sum exactly once every `window`
+ * updates, which is O(1) amortized) and never allocates. The values produced are
+ * identical to the last element of the corresponding batch function run over the
+ * history plus all prices pushed so far; for the SMA they agree within
+ * SIMD_RELATIVE_TOLERANCE unless set_rolling_simd(0) selects the scalar kernels.
+ *
+ * The append_*_stream functions push a block of new prices and write one output per
+ * price, so extending a previously computed series by `count` bars costs O(count)
+ * regardless of the length of its history.
+ */
+
+typedef struct SMAStream SMAStream;
+typedef struct EMAStream EMAStream;
+typedef struct RSIStream RSIStream;
+
+/**
+ * @brief Creates a streaming SMA seeded from a price history.
+ *
+ * @param history Pointer to the warm-up prices, oldest first.
+ * @param length  Number of prices in `history`; must be at least `window`.
+ * @param window  The size of the moving average window (number of periods).
+ *
+ * @return Pointer to a new stream, or NULL if input is invalid or memory allocation fails.
+ *
+ * @note Release the stream with cleanup_SMA_stream().
+ */
+DLL_EXPORT SMAStream *init_SMA_stream(const double *history, int length, int window);
+
+/**
+ * @brief Pushes the next price into a streaming SMA.
+ *
+ * @return The SMA of the latest `window` prices, or NAN if `stream` is NULL.
+ */
+DLL_EXPORT double update_SMA_stream(SMAStream *stream, double price);
+
+/**
+ * @brief Returns the latest SMA value without advancing the stream (NAN if `stream` is NULL).
+ */
+DLL_EXPORT double get_SMA_stream_value(const SMAStream *stream);
+
+/**
+ * @brief Pushes `count` prices into a streaming SMA.
+ *
+ * @param prices     The new prices, oldest first.
+ * @param count      Number of new prices (0 does nothing).
+ * @param SMA_Values Receives `count` values: SMA_Values[i] is the SMA after pushing prices[i].
+ *
+ * @return SUCCESS, or FAILURE if input parameters are invalid.
+ */
+DLL_EXPORT int append_SMA_stream(SMAStream *stream, const double *prices, int count, double *SMA_Values);
+
+/**
+ * @brief Frees a stream created by init_SMA_stream(). NULL is ignored.
+ */
+DLL_EXPORT void cleanup_SMA_stream(SMAStream *stream);
+
+/**
+ * @brief Creates a streaming EMA seeded from a price history.
+ *
+ * The EMA is seeded with the SMA of the first `window` prices, as in compute_EMA.
+ *
+ * @param history Pointer to the warm-up prices, oldest first.
+ * @param length  Number of prices in `history`; must be at least `window`.
+ * @param window  The size of the moving average window (number of periods).
+ *
+ * @return Pointer to a new stream, or NULL if input is invalid or memory allocation fails.
+ *
+ * @note Release the stream with cleanup_EMA_stream().
+ */
+DLL_EXPORT EMAStream *init_EMA_stream(const double *history, int length, int window);
+
+/**
+ * @brief Pushes the next price into a streaming EMA.
+ *
+ * @return The updated EMA value, or NAN if `stream` is NULL.
+ */
+DLL_EXPORT double update_EMA_stream(EMAStream *stream, double price);
+
+/**
+ * @brief Returns the latest EMA value without advancing the stream (NAN if `stream` is NULL).
+ */
+DLL_EXPORT double get_EMA_stream_value(const EMAStream *stream);
+
+/**
+ * @brief Pushes `count` prices into a streaming EMA, writing the EMA after each one to
+ *        `EMA_Values`. See append_SMA_stream().
+ */
+DLL_EXPORT int append_EMA_stream(EMAStream *stream, const double *prices, int count, double *EMA_Values);
+
+/**
+ * @brief Frees a stream created by init_EMA_stream(). NULL is ignored.
+ */
+DLL_EXPORT void cleanup_EMA_stream(EMAStream *stream);
+
+/**
+ * @brief Creates a streaming RSI seeded from a price history.
+ *
+ * The average gain and loss are seeded over the first `window` price changes and then
+ * smoothed with Wilder's method, as in compute_RSI.
+ *
+ * @param history Pointer to the warm-up prices, oldest first.
+ * @param length  Number of prices in `history`; must be at least `window + 1`.
+ * @param window  Lookback period over which RSI is calculated (typically 14).
+ *
+ * @return Pointer to a new stream, or NULL if input is invalid or memory allocation fails.
+ *
+ * @note Release the stream with cleanup_RSI_stream().
+ */
+DLL_EXPORT RSIStream *init_RSI_stream(const double *history, int length, int window);
+
+/**
+ * @brief Pushes the next price into a streaming RSI.
+ *
+ * @return The updated RSI value, or NAN if `stream` is NULL.
+ */
+DLL_EXPORT double update_RSI_stream(RSIStream *stream, double price);
+
+/**
+ * @brief Returns the latest RSI value without advancing the stream (NAN if `stream` is NULL).
+ */
+DLL_EXPORT double get_RSI_stream_value(const RSIStream *stream);
+
+/**
+ * @brief Pushes `count` prices into a streaming RSI, writing the RSI after each one to
+ *        `RSI_Values`. See append_SMA_stream().
+ */
+DLL_EXPORT int append_RSI_stream(RSIStream *stream, const double *prices, int count, double *RSI_Values);
+
+/**
+ * @brief Frees a stream created by init_RSI_stream(). NULL is ignored.
+ */
+DLL_EXPORT void cleanup_RSI_stream(RSIStream *stream);
+
+typedef struct MACDStream MACDStream;
+
+/**
+ * @brief A single MACD reading produced by a streaming MACD.
+ */
+typedef struct
+{
+    double MACD_Value;
+    double signal_line_Value;
+    double histogram_Value; // MACD_Value - signal_line_Value
+} MACDPoint;
+
+/**
+ * @brief Creates a streaming MACD seeded from a price history.
+ *
+ * The MACD line is the difference between the `fast_period` and `slow_period` EMAs and the
+ * signal line is a `signal_period` EMA of the MACD line. With the default periods
+ * (MACD_FAST_PERIOD, MACD_SLOW_PERIOD, MACD_SIGNAL_PERIOD) the stream reproduces compute_MACD.
+ *
+ * @param history       Pointer to the warm-up prices, oldest first.
+ * @param length        Number of prices in `history`; must be at least
+ *                      `slow_period + signal_period - 1` so the first point is available.
+ * @param fast_period   Period of the fast EMA (typically 12).
+ * @param slow_period   Period of the slow EMA (typically 26); must be greater than `fast_period`.
+ * @param signal_period Period of the signal line EMA (typically 9).
+ *
+ * @return Pointer to a new stream, or NULL if input is invalid or memory allocation fails.
+ *
+ * @note Release the stream with cleanup_MACD_stream().
+ */
+DLL_EXPORT MACDStream *init_MACD_stream(const double *history, int length, int fast_period, int slow_period, int signal_period);
+
+/**
+ * @brief Pushes the next price into a streaming MACD in O(1).
+ *
+ * @param point Receives the updated MACD, signal line and histogram values.
+ *
+ * @return SUCCESS, or FAILURE if `stream` or `point` is NULL.
+ */
+DLL_EXPORT int update_MACD_stream(MACDStream *stream, double price, MACDPoint *point);
+
+/**
+ * @brief Reads the latest MACD point without advancing the stream.
+ *
+ * @return SUCCESS, or FAILURE if `stream` or `point` is NULL.
+ */
+DLL_EXPORT int get_MACD_stream_point(const MACDStream *stream, MACDPoint *point);
+
+/**
+ * @brief Pushes `count` prices into a streaming MACD, writing one point per price.
+ *
+ * @param MACD_Values        Receives `count` MACD values.
+ * @param signal_line_Values Receives `count` signal line values.
+ * @param histogram_Values   Receives `count` histogram values, or NULL to skip them.
+ *
+ * @return SUCCESS, or FAILURE if input parameters are invalid.
+ */
+DLL_EXPORT int append_MACD_stream(MACDStream *stream, const double *prices, int count, double *MACD_Values,
+                                  double *signal_line_Values, double *histogram_Values);
+
+/**
+ * @brief Frees a stream created by init_MACD_stream(). NULL is ignored.
+ */
+DLL_EXPORT void cleanup_MACD_stream(MACDStream *stream);
+
+typedef struct OBVStream OBVStream;
+
+/**
+ * @brief Creates a streaming OBV seeded from a price and volume history.
+ *
+ * @param prices  Pointer to the warm-up prices, oldest first.
+ * @param volumes Pointer to the warm-up volumes.
+ * @param length  Number of bars in the history; must be at least 1.
+ *
+ * @return Pointer to a new stream, or NULL if input is invalid or memory allocation fails.
+ *
+ * @note Release the stream with cleanup_OBV_stream().
+ */
+DLL_EXPORT OBVStream *init_OBV_stream(const double *prices, const double *volumes, int length);
+
+/**
+ * @brief Pushes the next bar into a streaming OBV.
+ *
+ * @return The updated OBV value, or NAN if `stream` is NULL.
+ */
+DLL_EXPORT double update_OBV_stream(OBVStream *stream, double price, double volume);
+
+/**
+ * @brief Returns the latest OBV value without advancing the stream (NAN if `stream` is NULL).
+ */
+DLL_EXPORT double get_OBV_stream_value(const OBVStream *stream);
+
+/**
+ * @brief Pushes `count` bars into a streaming OBV, writing the OBV after each one to
+ *        `OBV_values`. See append_SMA_stream().
+ */
+DLL_EXPORT int append_OBV_stream(OBVStream *stream, const double *prices, const double *volumes, int count,
+                                 double *OBV_values);
+
+/**
+ * @brief Frees a stream created by init_OBV_stream(). NULL is ignored.
+ */
+DLL_EXPORT void cleanup_OBV_stream(OBVStream *stream);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // INDICATORS_H
@@ -0,0 +1,204 @@
+/**
+ * interleaved.c
+ * -------------
+ * EMA, RSI and MACD for many symbols stored time-major, one symbol per vector lane.
+ *
+ * These recurrences depend on their previous output, so they cannot be vectorized along
+ * time. Symbols are independent, though, and in a time-major layout the prices of
+ * neighbouring symbols at the same time step are adjacent: one vector load fetches a time
+ * step for 4 (AVX2) or 8 (AVX-512) symbols and every arithmetic instruction advances all
+ * of them at once. The kernel bodies live in lane_kernels.h and are compiled once per
+ * instruction set.
+ */
+
+#include "panel.h"
+#include "simd.h"
+#include <stdio.h>
+
+typedef struct
+{
+    const double *prices;
+    size_t stride; // doubles between consecutive time steps
+    int length;
+    int window;
+    int fast_period;
+    int slow_period;
+    int signal_period;
+    double *outs[3]; // output planes, same stride as the prices; outs[2] may be NULL for MACD
+} LaneJob;
+
+typedef void (*LaneKernel)(const LaneJob *job, int symbol);
+
+/* ------------------------------------------------------ scalar (1 lane), any platform */
+
+#define LANE_SUFFIX scalar
+#define LANE_TARGET
+#define VEC double
+#define LOAD(p) (*(p))
+#define STORE(p, v) (*(p) = (v))
+#define SET1(x) (x)
+#define ADD(a, b) ((a) + (b))
+#define SUB(a, b) ((a) - (b))
+#define MUL(a, b) ((a) * (b))
+#define DIV(a, b) ((a) / (b))
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+#define SELECT_IF_ZERO(x, a, b) (((x) == 0) ? (a) : (b))
+#include "lane_kernels.h"
+#undef LANE_SUFFIX
+#undef LANE_TARGET
+#undef VEC
+#undef LOAD
+#undef STORE
+#undef SET1
+#undef ADD
+#undef SUB
+#undef MUL
+#undef DIV
+#undef MAX
+#undef SELECT_IF_ZERO
+
+#ifdef SIMD_X86
+
+/* ---------------------------------------------------------------- AVX2 (4 lanes) */
+
+#define LANE_SUFFIX avx2
+#define LANE_TARGET __attribute__((target("avx2")))
+#define VEC __m256d
+#define LOAD(p) _mm256_loadu_pd(p)
+#define STORE(p, v) _mm256_storeu_pd((p), (v))
+#define SET1(x) _mm256_set1_pd(x)
+#define ADD(a, b) _mm256_add_pd((a), (b))
+#define SUB(a, b) _mm256_sub_pd((a), (b))
+#define MUL(a, b) _mm256_mul_pd((a), (b))
+#define DIV(a, b) _mm256_div_pd((a), (b))
+#define MAX(a, b) _mm256_max_pd((a), (b))
+#define SELECT_IF_ZERO(x, a, b) _mm256_blendv_pd((b), (a), _mm256_cmp_pd((x), _mm256_setzero_pd(), _CMP_EQ_OQ))
+#include "lane_kernels.h"
+#undef LANE_SUFFIX
+#undef LANE_TARGET
+#undef VEC
+#undef LOAD
+#undef STORE
+#undef SET1
+#undef ADD
+#undef SUB
+#undef MUL
+#undef DIV
+#undef MAX
+#undef SELECT_IF_ZERO
+
+/* ------------------------------------------------------------- AVX-512 (8 lanes) */
+
+#define LANE_SUFFIX avx512
+#define LANE_TARGET __attribute__((target("avx512f")))
+#define VEC __m512d
+#define LOAD(p) _mm512_loadu_pd(p)
+#define STORE(p, v) _mm512_storeu_pd((p), (v))
+#define SET1(x) _mm512_set1_pd(x)
+#define ADD(a, b) _mm512_add_pd((a), (b))
+#define SUB(a, b) _mm512_sub_pd((a), (b))
+#define MUL(a, b) _mm512_mul_pd((a), (b))
+#define DIV(a, b) _mm512_div_pd((a), (b))
+#define MAX(a, b) _mm512_max_pd((a), (b))
+#define SELECT_IF_ZERO(x, a, b) _mm512_mask_blend_pd(_mm512_cmp_pd_mask((x), _mm512_setzero_pd(), _CMP_EQ_OQ), (b), (a))
+#include "lane_kernels.h"
+#undef LANE_SUFFIX
+#undef LANE_TARGET
+#undef VEC
+#undef LOAD
+#undef STORE
+#undef SET1
+#undef ADD
+#undef SUB
+#undef MUL
+#undef DIV
+#undef MAX
+#undef SELECT_IF_ZERO
+
+#endif // SIMD_X86
+
+/**
+ * Runs a kernel over every symbol: full 8-lane then 4-lane blocks as far as the active
+ * SIMD level allows, and the leftover symbols one at a time.
+ */
+static void run_lanes(const LaneJob *job, int symbols, LaneKernel scalar, LaneKernel avx2, LaneKernel avx512)
+{
+    int symbol = 0;
+#ifdef SIMD_X86
+    int level = get_simd_level();
+    if (level >= SIMD_AVX512)
+    {
+        for (; symbol + 8 <= symbols; symbol += 8)
+        {
+            avx512(job, symbol);
+        }
+    }
+    if (level >= SIMD_AVX2)
+    {
+        for (; symbol + 4 <= symbols; symbol += 4)
+        {
+            avx2(job, symbol);
+        }
+    }
+#else
+    (void)avx2;
+    (void)avx512;
+#endif
+    for (; symbol < symbols; symbol++)
+    {
+        scalar(job, symbol);
+    }
+}
+
+#ifdef SIMD_X86
+#define LANE_KERNELS(name) name##_scalar, name##_avx2, name##_avx512
+#else
+#define LANE_KERNELS(name) name##_scalar, NULL, NULL
+#endif
+
+DLL_EXPORT int compute_EMA_interleaved(const double *prices, size_t stride, int symbols, int length, int window,
+                                       double *EMA_Values)
+{
+    if (!prices || !EMA_Values || symbols <= 0 || stride < (size_t)symbols ||
+        compute_output_length(INDICATOR_EMA, length, window) <= 0)
+    {
+        fprintf(stderr, "Invalid input.\n");
+        return FAILURE;
+    }
+
+    LaneJob job = {prices, stride, length, window, 0, 0, 0, {EMA_Values, NULL, NULL}};
+    run_lanes(&job, symbols, LANE_KERNELS(ema_lanes));
+    return SUCCESS;
+}
+
+DLL_EXPORT int compute_RSI_interleaved(const double *prices, size_t stride, int symbols, int length, int window,
+                                       double *RSI_Values)
+{
+    if (!prices || !RSI_Values || symbols <= 0 || stride < (size_t)symbols ||
+        compute_output_length(INDICATOR_RSI, length, window) <= 0)
+    {
+        fprintf(stderr, "Invalid input.\n");
+        return FAILURE;
+    }
+
+    LaneJob job = {prices, stride, length, window, 0, 0, 0, {RSI_Values, NULL, NULL}};
+    run_lanes(&job, symbols, LANE_KERNELS(rsi_lanes));
+    return SUCCESS;
+}
+
+DLL_EXPORT int compute_MACD_interleaved(const double *prices, size_t stride, int symbols, int length,
+                                        int fast_period, int slow_period, int signal_period,
+                                        double *MACD_Values, double *signal_line_Values, double *histogram_Values)
+{
+    if (!prices || !MACD_Values || !signal_line_Values || symbols <= 0 || stride < (size_t)symbols ||
+        compute_MACD_output_length(length, fast_period, slow_period, signal_period) <= 0)
+    {
+        fprintf(stderr, "Invalid input.\n");
+        return FAILURE;
+    }
+
+    LaneJob job = {prices, stride, length, 0, fast_period, slow_period, signal_period,
+                   {MACD_Values, signal_line_Values, histogram_Values}};
+    run_lanes(&job, symbols, LANE_KERNELS(macd_lanes));
+    return SUCCESS;
+}
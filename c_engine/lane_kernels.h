@@ -0,0 +1,154 @@
+/**
+ * lane_kernels.h
+ * --------------
+ * Body of the one-symbol-per-lane EMA, RSI and MACD kernels, included by interleaved.c
+ * once per instruction set. No include guard on purpose.
+ *
+ * Before including, define:
+ *  LANE_SUFFIX   name suffix of the generated functions
+ *  LANE_TARGET   function attribute selecting the instruction set (may be empty)
+ *  VEC           vector type holding one double per symbol
+ *  LOAD, STORE, SET1, ADD, SUB, MUL, DIV
+ *  MAX(a, b)             a > b ? a : b per lane (b when a is NaN)
+ *  SELECT_IF_ZERO(x, a, b)  x == 0 ? a : b per lane
+ *
+ * Every lane performs the operations of ema_kernel(), compute_RSI_into() and macd_step()
+ * in indicators.c in the same order, so each symbol's results are bit-identical to them.
+ */
+
+#define LANE_NAME_(name, suffix) name##_##suffix
+#define LANE_NAME(name, suffix) LANE_NAME_(name, suffix)
+
+LANE_TARGET static void LANE_NAME(ema_lanes, LANE_SUFFIX)(const LaneJob *job, int symbol)
+{
+    const double *prices = job->prices + symbol;
+    double *EMA_Values = job->outs[0] + symbol;
+    size_t stride = job->stride;
+    int window = job->window;
+    VEC alpha = SET1(2.0 / ((double)window + 1.0));
+
+    VEC sum = SET1(0.0);
+    for (int t = 0; t < window; t++)
+    {
+        sum = ADD(sum, LOAD(prices + t * stride));
+    }
+    VEC ema = DIV(sum, SET1((double)window));
+    STORE(EMA_Values, ema);
+
+    for (int t = window; t < job->length; t++)
+    {
+        ema = ADD(MUL(SUB(LOAD(prices + t * stride), ema), alpha), ema);
+        STORE(EMA_Values + (t - window + 1) * stride, ema);
+    }
+}
+
+LANE_TARGET static void LANE_NAME(rsi_lanes, LANE_SUFFIX)(const LaneJob *job, int symbol)
+{
+    const double *prices = job->prices + symbol;
+    double *RSI_Values = job->outs[0] + symbol;
+    size_t stride = job->stride;
+    int window = job->window;
+    VEC zero = SET1(0.0);
+    VEC minus_one = SET1(-1.0);
+    VEC one = SET1(1.0);
+    VEC hundred = SET1(100.0);
+    VEC periods = SET1((double)window);
+    VEC kept = SET1((double)(window - 1));
+
+    // seed: plain averages of the first `window` gains and losses
+    VEC gain_sum = zero;
+    VEC loss_sum = zero;
+    VEC previous = LOAD(prices);
+    for (int t = 1; t <= window; t++)
+    {
+        VEC price = LOAD(prices + t * stride);
+        VEC change = SUB(price, previous);
+        gain_sum = ADD(gain_sum, MAX(change, zero));
+        loss_sum = ADD(loss_sum, MAX(MUL(minus_one, change), zero));
+        previous = price;
+    }
+    VEC avg_gain = DIV(gain_sum, periods);
+    VEC avg_loss = DIV(loss_sum, periods);
+    STORE(RSI_Values, SELECT_IF_ZERO(avg_loss, hundred, SUB(hundred, DIV(hundred, ADD(one, DIV(avg_gain, avg_loss))))));
+
+    // Wilder's smoothing
+    for (int t = window + 1; t < job->length; t++)
+    {
+        VEC price = LOAD(prices + t * stride);
+        VEC change = SUB(price, previous);
+        avg_gain = DIV(ADD(MUL(avg_gain, kept), MAX(change, zero)), periods);
+        avg_loss = DIV(ADD(MUL(avg_loss, kept), MAX(MUL(minus_one, change), zero)), periods);
+        STORE(RSI_Values + (t - window) * stride,
+              SELECT_IF_ZERO(avg_loss, hundred, SUB(hundred, DIV(hundred, ADD(one, DIV(avg_gain, avg_loss))))));
+        previous = price;
+    }
+}
+
+LANE_TARGET static void LANE_NAME(macd_lanes, LANE_SUFFIX)(const LaneJob *job, int symbol)
+{
+    const double *prices = job->prices + symbol;
+    double *MACD_Values = job->outs[0] + symbol;
+    double *signal_line_Values = job->outs[1] + symbol;
+    double *histogram_Values = job->outs[2] ? job->outs[2] + symbol : NULL;
+    size_t stride = job->stride;
+    int fast_period = job->fast_period;
+    int slow_period = job->slow_period;
+    int warmup = slow_period + job->signal_period - 1;
+    VEC fast_alpha = SET1(2.0 / ((double)fast_period + 1.0));
+    VEC slow_alpha = SET1(2.0 / ((double)slow_period + 1.0));
+    VEC signal_alpha = SET1(2.0 / ((double)job->signal_period + 1.0));
+
+    // the seed sums are held in the EMA variables, as in macd_step()
+    VEC fast_ema = SET1(0.0);
+    VEC slow_ema = SET1(0.0);
+    VEC signal_ema = SET1(0.0);
+    for (int t = 0; t < job->length; t++)
+    {
+        VEC price = LOAD(prices + t * stride);
+
+        if (t < fast_period)
+        {
+            fast_ema = ADD(fast_ema, price);
+            if (t == fast_period - 1)
+                fast_ema = DIV(fast_ema, SET1((double)fast_period));
+        }
+        else
+        {
+            fast_ema = ADD(MUL(SUB(price, fast_ema), fast_alpha), fast_ema);
+        }
+
+        if (t < slow_period)
+        {
+            slow_ema = ADD(slow_ema, price);
+            if (t < slow_period - 1)
+                continue;
+            slow_ema = DIV(slow_ema, SET1((double)slow_period));
+        }
+        else
+        {
+            slow_ema = ADD(MUL(SUB(price, slow_ema), slow_alpha), slow_ema);
+        }
+
+        VEC macd = SUB(fast_ema, slow_ema);
+        if (t < warmup)
+        {
+            signal_ema = ADD(signal_ema, macd);
+            if (t < warmup - 1)
+                continue;
+            signal_ema = DIV(signal_ema, SET1((double)job->signal_period));
+        }
+        else
+        {
+            signal_ema = ADD(MUL(SUB(macd, signal_ema), signal_alpha), signal_ema);
+        }
+
+        size_t row = (size_t)(t - warmup + 1) * stride;
+        STORE(MACD_Values + row, macd);
+        STORE(signal_line_Values + row, signal_ema);
+        if (histogram_Values)
+            STORE(histogram_Values + row, SUB(macd, signal_ema));
+    }
+}
+
+#undef LANE_NAME
+#undef LANE_NAME_
@@ -0,0 +1,447 @@
+/**
+ * panel.c
+ * -------
+ * Computes indicators for many symbols in one call over a contiguous symbols x time matrix.
+ *
+ * Row-major panels are processed in place, one symbol row at a time. Column-major panels
+ * are gathered a block of symbols at a time into contiguous scratch rows, so each cache
+ * line read from the input is fully used, computed with the regular kernels, and
+ * scattered back in the same layout. EMA, RSI and MACD skip the gather: their
+ * interleaved kernels read the column-major matrix directly, one symbol per SIMD lane.
+ */
+
+#include "panel.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <string.h>
+#include <math.h>
+
+#define PANEL_GATHER_BLOCK 8 // symbols gathered together from a column-major panel
+
+DLL_EXPORT int indicator_output_planes(IndicatorType type)
+{
+    return (type == INDICATOR_BOLLINGER || type == INDICATOR_MACD) ? 3 : 1;
+}
+
+DLL_EXPORT int indicator_lead(const IndicatorSpec *spec)
+{
+    if (!spec)
+        return -1;
+
+    switch (spec->type)
+    {
+    case INDICATOR_SMA:
+    case INDICATOR_EMA:
+        return (spec->window > 0) ? spec->window - 1 : -1;
+    case INDICATOR_BOLLINGER:
+        return (spec->window > 0 && spec->std_devs > 0) ? spec->window - 1 : -1;
+    case INDICATOR_RSI:
+        return (spec->window > 0) ? spec->window : -1;
+    case INDICATOR_MACD:
+        if (spec->fast_period <= 0 || spec->slow_period <= spec->fast_period || spec->signal_period <= 0)
+            return -1;
+        return spec->slow_period + spec->signal_period - 2;
+    case INDICATOR_OBV:
+        return 0;
+    }
+    return -1;
+}
+
+/**
+ * Number of defined values the spec produces for a series of `length` prices, or -1 if
+ * the series is too short.
+ */
+static int spec_output_length(const IndicatorSpec *spec, int length)
+{
+    switch (spec->type)
+    {
+    case INDICATOR_MACD:
+        return compute_MACD_output_length(length, spec->fast_period, spec->slow_period, spec->signal_period);
+    default:
+        return compute_output_length(spec->type, length, spec->window);
+    }
+}
+
+static void fill_nan(double *values, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        values[i] = NAN;
+    }
+}
+
+DLL_EXPORT int compute_indicator_aligned(const IndicatorSpec *spec, const double *prices, const double *volumes,
+                                         int length, double *out, size_t plane_stride)
+{
+    int lead = indicator_lead(spec);
+    if (!prices || !out || length < 0 || lead < 0 || (spec->type == INDICATOR_OBV && !volumes))
+    {
+        fprintf(stderr, "Invalid input.\n");
+        return FAILURE;
+    }
+
+    int planes = indicator_output_planes(spec->type);
+    if (spec_output_length(spec, length) <= 0)
+    {
+        // too short for this indicator: nothing is defined
+        for (int p = 0; p < planes; p++)
+        {
+            fill_nan(out + p * plane_stride, length);
+        }
+        return SUCCESS;
+    }
+
+    for (int p = 0; p < planes; p++)
+    {
+        fill_nan(out + p * plane_stride, lead);
+    }
+
+    // every kernel writes exactly length - lead values, starting at the lead
+    switch (spec->type)
+    {
+    case INDICATOR_SMA:
+        return compute_SMA_into(prices, length, spec->window, out + lead);
+    case INDICATOR_EMA:
+        return compute_EMA_into(prices, length, spec->window, out + lead);
+    case INDICATOR_RSI:
+        return compute_RSI_into(prices, length, spec->window, out + lead);
+    case INDICATOR_BOLLINGER:
+        return compute_bollinger_bands_into(prices, length, spec->window, spec->std_devs,
+                                            out + lead, out + plane_stride + lead, out + 2 * plane_stride + lead);
+    case INDICATOR_MACD:
+        return compute_MACD_periods_into(prices, length, spec->fast_period, spec->slow_period, spec->signal_period,
+                                         out + lead, out + plane_stride + lead, out + 2 * plane_stride + lead);
+    case INDICATOR_OBV:
+        return compute_OBV_into(prices, volumes, length, out);
+    }
+    return FAILURE;
+}
+
+static int same_spec(const IndicatorSpec *a, const IndicatorSpec *b)
+{
+    if (a->type != b->type)
+        return 0;
+    switch (a->type)
+    {
+    case INDICATOR_SMA:
+    case INDICATOR_EMA:
+    case INDICATOR_RSI:
+        return a->window == b->window;
+    case INDICATOR_BOLLINGER:
+        return a->window == b->window && a->std_devs == b->std_devs;
+    case INDICATOR_MACD:
+        return a->fast_period == b->fast_period && a->slow_period == b->slow_period &&
+               a->signal_period == b->signal_period;
+    case INDICATOR_OBV:
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * Index of the spec whose output specs[k]'s can be copied from, or -1 if it must be computed:
+ * for an SMA the first Bollinger spec with the same window (its middle band comes first),
+ * otherwise the first equal spec before it. The spec returned is always computed itself.
+ */
+static int shared_source(const IndicatorSpec *specs, int spec_count, int k)
+{
+    if (specs[k].type == INDICATOR_SMA)
+    {
+        for (int j = 0; j < spec_count; j++)
+        {
+            if (specs[j].type == INDICATOR_BOLLINGER && specs[j].window == specs[k].window)
+                return j;
+        }
+    }
+    for (int j = 0; j < k; j++)
+    {
+        if (same_spec(&specs[j], &specs[k]))
+            return j;
+    }
+    return -1;
+}
+
+DLL_EXPORT int compute_indicator_set(const IndicatorSpec *specs, int spec_count, const double *prices,
+                                     const double *volumes, int length, double **outs)
+{
+    if (!specs || !outs || !prices || spec_count <= 0 || length < 0)
+    {
+        fprintf(stderr, "Invalid input.\n");
+        return FAILURE;
+    }
+    for (int k = 0; k < spec_count; k++)
+    {
+        if (!outs[k] || indicator_lead(&specs[k]) < 0 || (specs[k].type == INDICATOR_OBV && !volumes))
+        {
+            fprintf(stderr, "Invalid input.\n");
+            return FAILURE;
+        }
+    }
+
+    // the first RSI and OBV specs are fused when the series is long enough for the RSI
+    int rsi = -1;
+    int obv = -1;
+    for (int k = 0; k < spec_count; k++)
+    {
+        if (specs[k].type == INDICATOR_RSI && rsi < 0)
+            rsi = k;
+        if (specs[k].type == INDICATOR_OBV && obv < 0)
+            obv = k;
+    }
+    int fuse = rsi >= 0 && obv >= 0 && spec_output_length(&specs[rsi], length) > 0;
+
+    for (int k = 0; k < spec_count; k++)
+    {
+        if (shared_source(specs, spec_count, k) >= 0 || (fuse && k == obv))
+            continue;
+
+        if (fuse && k == rsi)
+        {
+            int lead = indicator_lead(&specs[rsi]);
+            fill_nan(outs[rsi], lead);
+            compute_RSI_OBV_into(prices, volumes, length, specs[rsi].window, outs[rsi] + lead, outs[obv]);
+        }
+        else
+        {
+            compute_indicator_aligned(&specs[k], prices, volumes, length, outs[k], length);
+        }
+    }
+
+    // copies last, once every source has been computed
+    for (int k = 0; k < spec_count; k++)
+    {
+        int source = shared_source(specs, spec_count, k);
+        if (source >= 0)
+            memcpy(outs[k], outs[source], sizeof(double) * indicator_output_planes(specs[k].type) * length);
+    }
+    return SUCCESS;
+}
+
+DLL_EXPORT size_t panel_scratch_length(const PricePanel *panel, IndicatorType type)
+{
+    if (!panel || panel->time_steps <= 0)
+        return 0;
+    // per gathered symbol: one price row, one volume row and the output planes
+    return (size_t)PANEL_GATHER_BLOCK * (2 + indicator_output_planes(type)) * (size_t)panel->time_steps;
+}
+
+/**
+ * Checks the panel and spec, and the lengths of symbols [first_symbol, last_symbol) only,
+ * so that computing a small range does not pay for validating the whole panel.
+ */
+static int panel_is_valid(const PricePanel *panel, const IndicatorSpec *spec, const double *out,
+                          int first_symbol, int last_symbol)
+{
+    if (!panel || !panel->prices || !out || panel->symbols <= 0 || panel->time_steps <= 0 ||
+        indicator_lead(spec) < 0 || (spec->type == INDICATOR_OBV && !panel->volumes) ||
+        (panel->layout != PANEL_ROW_MAJOR && panel->layout != PANEL_COLUMN_MAJOR))
+    {
+        return 0;
+    }
+    if (first_symbol < 0 || last_symbol > panel->symbols || first_symbol > last_symbol)
+        return 0;
+    if (panel->lengths)
+    {
+        for (int s = first_symbol; s < last_symbol; s++)
+        {
+            if (panel->lengths[s] < 0 || panel->lengths[s] > panel->time_steps)
+                return 0;
+        }
+    }
+    return 1;
+}
+
+static void compute_rows(const PricePanel *panel, const IndicatorSpec *spec, double *out, int first_symbol, int last_symbol)
+{
+    size_t time_steps = panel->time_steps;
+    size_t plane_stride = (size_t)panel->symbols * time_steps;
+    int planes = indicator_output_planes(spec->type);
+
+    for (int s = first_symbol; s < last_symbol; s++)
+    {
+        int length = panel->lengths ? panel->lengths[s] : panel->time_steps;
+        const double *volumes = panel->volumes ? panel->volumes + s * time_steps : NULL;
+        double *row = out + s * time_steps;
+
+        compute_indicator_aligned(spec, panel->prices + s * time_steps, volumes, length, row, plane_stride);
+        for (int p = 0; p < planes; p++)
+        {
+            fill_nan(row + p * plane_stride + length, panel->time_steps - length);
+        }
+    }
+}
+
+static void compute_columns(const PricePanel *panel, const IndicatorSpec *spec, double *out,
+                            int first_symbol, int last_symbol, double *scratch)
+{
+    size_t symbols = panel->symbols;
+    size_t time_steps = panel->time_steps;
+    size_t plane_stride = symbols * time_steps;
+    int planes = indicator_output_planes(spec->type);
+
+    // scratch rows for one block: prices, volumes, then `planes` output rows per symbol
+    size_t row_stride = (2 + planes) * time_steps;
+
+    for (int block = first_symbol; block < last_symbol; block += PANEL_GATHER_BLOCK)
+    {
+        int count = (last_symbol - block < PANEL_GATHER_BLOCK) ? last_symbol - block : PANEL_GATHER_BLOCK;
+
+        // gather: walk time in the outer loop so consecutive symbols are read together
+        for (size_t t = 0; t < time_steps; t++)
+        {
+            const double *price_row = panel->prices + t * symbols + block;
+            const double *volume_row = panel->volumes ? panel->volumes + t * symbols + block : NULL;
+            for (int k = 0; k < count; k++)
+            {
+                scratch[k * row_stride + t] = price_row[k];
+                if (volume_row)
+                    scratch[k * row_stride + time_steps + t] = volume_row[k];
+            }
+        }
+
+        for (int k = 0; k < count; k++)
+        {
+            int length = panel->lengths ? panel->lengths[block + k] : panel->time_steps;
+            double *series = scratch + k * row_stride;
+            double *result = series + 2 * time_steps;
+
+            compute_indicator_aligned(spec, series, panel->volumes ? series + time_steps : NULL, length, result, time_steps);
+            for (int p = 0; p < planes; p++)
+            {
+                fill_nan(result + p * time_steps + length, panel->time_steps - length);
+            }
+        }
+
+        // scatter back into the column-major output planes
+        for (int p = 0; p < planes; p++)
+        {
+            double *plane = out + p * plane_stride;
+            for (size_t t = 0; t < time_steps; t++)
+            {
+                double *out_row = plane + t * symbols + block;
+                for (int k = 0; k < count; k++)
+                {
+                    out_row[k] = scratch[k * row_stride + (2 + p) * time_steps + t];
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Column-major EMA, RSI and MACD with the interleaved kernels, run over the longest series
+ * of the range. The kernels are causal, so the values of a shorter symbol up to its own
+ * length are unaffected by the prices past it; those positions are reset to NAN after.
+ */
+static void compute_columns_interleaved(const PricePanel *panel, const IndicatorSpec *spec, double *out,
+                                        int first_symbol, int last_symbol)
+{
+    size_t symbols = panel->symbols;
+    size_t plane_stride = symbols * panel->time_steps;
+    int planes = indicator_output_planes(spec->type);
+    int count = last_symbol - first_symbol;
+    int lead = indicator_lead(spec);
+    if (lead > panel->time_steps)
+        lead = panel->time_steps;
+
+    int longest = 0;
+    for (int s = first_symbol; s < last_symbol; s++)
+    {
+        int length = panel->lengths ? panel->lengths[s] : panel->time_steps;
+        if (length > longest)
+            longest = length;
+    }
+
+    if (spec_output_length(spec, longest) > 0)
+    {
+        const double *prices = panel->prices + first_symbol;
+        double *result = out + lead * symbols + first_symbol;
+        switch (spec->type)
+        {
+        case INDICATOR_EMA:
+            compute_EMA_interleaved(prices, symbols, count, longest, spec->window, result);
+            break;
+        case INDICATOR_RSI:
+            compute_RSI_interleaved(prices, symbols, count, longest, spec->window, result);
+            break;
+        case INDICATOR_MACD:
+            compute_MACD_interleaved(prices, symbols, count, longest, spec->fast_period, spec->slow_period,
+                                     spec->signal_period, result, result + plane_stride, result + 2 * plane_stride);
+            break;
+        default:
+            break;
+        }
+    }
+
+    for (int p = 0; p < planes; p++)
+    {
+        double *plane = out + p * plane_stride;
+        for (int t = 0; t < lead; t++)
+        {
+            fill_nan(plane + t * symbols + first_symbol, count);
+        }
+        for (int s = first_symbol; s < last_symbol; s++)
+        {
+            int length = panel->lengths ? panel->lengths[s] : panel->time_steps;
+            int first_undefined = (spec_output_length(spec, length) > 0) ? length : lead;
+            for (int t = first_undefined; t < panel->time_steps; t++)
+            {
+                plane[t * symbols + s] = NAN;
+            }
+        }
+    }
+}
+
+/**
+ * Whether the interleaved kernels beat gathering for this indicator. One lane at a time
+ * (no SIMD) they only add strided reads, so scalar builds keep the gather.
+ */
+static int use_interleaved(IndicatorType type)
+{
+    if (get_simd_level() == SIMD_SCALAR)
+        return 0;
+    return type == INDICATOR_EMA || type == INDICATOR_RSI || type == INDICATOR_MACD;
+}
+
+DLL_EXPORT int compute_panel_range(const PricePanel *panel, const IndicatorSpec *spec, double *out,
+                                   int first_symbol, int last_symbol, double *scratch)
+{
+    if (!panel_is_valid(panel, spec, out, first_symbol, last_symbol) || (panel->layout == PANEL_COLUMN_MAJOR && !scratch))
+    {
+        fprintf(stderr, "Invalid input.\n");
+        return FAILURE;
+    }
+
+    if (panel->layout == PANEL_ROW_MAJOR)
+        compute_rows(panel, spec, out, first_symbol, last_symbol);
+    else if (use_interleaved(spec->type))
+        compute_columns_interleaved(panel, spec, out, first_symbol, last_symbol);
+    else
+        compute_columns(panel, spec, out, first_symbol, last_symbol, scratch);
+    return SUCCESS;
+}
+
+DLL_EXPORT int compute_panel(const PricePanel *panel, const IndicatorSpec *spec, double *out)
+{
+    if (!panel_is_valid(panel, spec, out, 0, panel ? panel->symbols : 0))
+    {
+        fprintf(stderr, "Invalid input.\n");
+        return FAILURE;
+    }
+
+    double *scratch = NULL;
+    if (panel->layout == PANEL_COLUMN_MAJOR)
+    {
+        scratch = malloc(sizeof(double) * panel_scratch_length(panel, spec->type));
+        if (!scratch)
+        {
+            fprintf(stderr, "Malloc failed. %s.\n", strerror(errno));
+            return FAILURE;
+        }
+    }
+
+    int status = compute_panel_range(panel, spec, out, 0, panel->symbols, scratch);
+    free(scratch);
+    return status;
+}
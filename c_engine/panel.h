@@ -0,0 +1,199 @@
+/**
+ * panel.h
+ * -------
+ * Declarations for computing indicators over many symbols at once.
+ *
+ * A panel is a contiguous symbols x time matrix of prices. One call computes an indicator
+ * for every symbol into a single output matrix, so callers pay for one FFI call and one
+ * output buffer instead of one per symbol. The `_interleaved` kernels compute the
+ * recursive indicators directly on time-major data, one symbol per SIMD lane.
+ */
+
+#ifndef PANEL_H
+#define PANEL_H
+
+#include <stddef.h>
+#include "indicators.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Describes one indicator computation: which indicator and its parameters.
+ *
+ * Fields that do not apply to `type` are ignored.
+ */
+typedef struct
+{
+    IndicatorType type;
+    int window;        // SMA, EMA, RSI and Bollinger Bands lookback period
+    double std_devs;   // Bollinger Bands width in standard deviations
+    int fast_period;   // MACD fast EMA period
+    int slow_period;   // MACD slow EMA period
+    int signal_period; // MACD signal line period
+} IndicatorSpec;
+
+typedef enum
+{
+    PANEL_ROW_MAJOR,   // element (symbol, t) at prices[symbol * time_steps + t]
+    PANEL_COLUMN_MAJOR // element (symbol, t) at prices[t * symbols + symbol]
+} PanelLayout;
+
+/**
+ * @brief A symbols x time matrix of prices (and optionally volumes).
+ *
+ * Each symbol's series starts at t = 0 and holds `lengths[symbol]` valid prices; any
+ * values past that are ignored. When `lengths` is NULL every symbol holds `time_steps` prices.
+ */
+typedef struct
+{
+    const double *prices;  // symbols x time_steps matrix in `layout` order
+    const double *volumes; // same shape and layout as `prices`; required for OBV only
+    const int *lengths;    // valid prices per symbol (each <= time_steps), or NULL
+    int symbols;
+    int time_steps;
+    PanelLayout layout;
+} PricePanel;
+
+/**
+ * @brief Number of output arrays an indicator produces.
+ *
+ * @return 3 for Bollinger Bands (middle, top, bottom) and MACD (MACD, signal, histogram),
+ *         1 for every other indicator.
+ */
+DLL_EXPORT int indicator_output_planes(IndicatorType type);
+
+/**
+ * @brief Index of the first price that has a defined indicator value.
+ *
+ * @return window - 1 for SMA, EMA and Bollinger Bands, window for RSI,
+ *         slow_period + signal_period - 2 for MACD, 0 for OBV, or -1 if `spec` is invalid.
+ */
+DLL_EXPORT int indicator_lead(const IndicatorSpec *spec);
+
+/**
+ * @brief Computes one indicator for a single series, aligned with the input prices.
+ *
+ * Output value t of each plane corresponds with prices[t]; positions before
+ * indicator_lead(spec) are set to NAN. If the series is too short for the indicator
+ * every position is NAN.
+ *
+ * @param spec         The indicator and its parameters.
+ * @param prices       Pointer to `length` prices.
+ * @param volumes      Pointer to `length` volumes; required for OBV, otherwise may be NULL.
+ * @param length       Number of prices in the series.
+ * @param out          Pointer to indicator_output_planes(spec->type) planes of `length` doubles.
+ * @param plane_stride Distance, in doubles, between the starts of consecutive output planes.
+ *
+ * @return SUCCESS, or FAILURE if the spec or pointers are invalid.
+ */
+DLL_EXPORT int compute_indicator_aligned(const IndicatorSpec *spec, const double *prices, const double *volumes,
+                                         int length, double *out, size_t plane_stride);
+
+/**
+ * @brief Computes several indicators for one series in a single call, sharing work between them.
+ *
+ * Each output is laid out as for compute_indicator_aligned with a plane stride of `length`.
+ * Work is shared where the results are provably identical:
+ *  - a spec equal to an earlier one is copied from it;
+ *  - an SMA is copied from the middle band of a Bollinger spec with the same window;
+ *  - the first RSI and the first OBV are computed in one pass over the price changes
+ *    (compute_RSI_OBV_into).
+ * Every value is identical to computing the spec on its own.
+ *
+ * @param specs      Array of `spec_count` indicators.
+ * @param spec_count Number of indicators.
+ * @param prices     Pointer to `length` prices.
+ * @param volumes    Pointer to `length` volumes; required if any spec is OBV, otherwise may be NULL.
+ * @param length     Number of prices in the series.
+ * @param outs       Array of `spec_count` output buffers, each of
+ *                   indicator_output_planes(specs[k].type) * length doubles.
+ *
+ * @return SUCCESS, or FAILURE if any spec or pointer is invalid (nothing is computed then).
+ */
+DLL_EXPORT int compute_indicator_set(const IndicatorSpec *specs, int spec_count, const double *prices,
+                                     const double *volumes, int length, double **outs);
+
+/**
+ * @brief Computes an indicator for every symbol of a panel.
+ *
+ * The output has indicator_output_planes(spec->type) planes, each a symbols x time_steps
+ * matrix in the same layout as the input, stored back to back. Within a plane, value
+ * (symbol, t) corresponds with price (symbol, t); warm-up positions, positions past the
+ * symbol's length and symbols too short for the indicator are NAN.
+ *
+ * @param panel The input matrix.
+ * @param spec  The indicator and its parameters.
+ * @param out   Pointer to planes * symbols * time_steps doubles.
+ *
+ * @return SUCCESS, or FAILURE on invalid input or memory allocation failure.
+ */
+DLL_EXPORT int compute_panel(const PricePanel *panel, const IndicatorSpec *spec, double *out);
+
+/**
+ * @brief Computes an indicator for symbols [first_symbol, last_symbol) of a panel.
+ *
+ * Same output as compute_panel for those symbols, leaving the rest of `out` untouched.
+ * Lets callers split a panel across their own threads.
+ *
+ * @param scratch For PANEL_COLUMN_MAJOR, pointer to panel_scratch_length(panel, spec->type)
+ *                doubles of working memory owned by the calling thread; ignored (may be NULL)
+ *                for PANEL_ROW_MAJOR.
+ *
+ * @return SUCCESS, or FAILURE on invalid input.
+ */
+DLL_EXPORT int compute_panel_range(const PricePanel *panel, const IndicatorSpec *spec, double *out,
+                                   int first_symbol, int last_symbol, double *scratch);
+
+/**
+ * @brief Number of scratch doubles compute_panel_range needs for a column-major panel.
+ */
+DLL_EXPORT size_t panel_scratch_length(const PricePanel *panel, IndicatorType type);
+
+/**
+ * @brief Computes the EMA of many symbols stored time-major (interleaved).
+ *
+ * The price of symbol s at time t is prices[t * stride + s]; value i of the symbol's EMA
+ * is written to EMA_Values[i * stride + s], for the same `length - window + 1` values as
+ * compute_EMA_into. Each symbol occupies one SIMD lane (4 with AVX2, 8 with AVX-512), so a
+ * single pass over time advances several recurrences at once. Results are bit-identical
+ * to compute_EMA_into on each symbol's series, at every SIMD level.
+ *
+ * @param prices     Pointer to the first symbol's first price.
+ * @param stride     Distance, in doubles, between consecutive time steps (>= symbols), so
+ *                   a block of columns of a column-major panel can be passed directly.
+ * @param symbols    Number of symbols.
+ * @param length     Number of time steps of every symbol.
+ * @param window     Lookback period.
+ * @param EMA_Values Output matrix with the same stride.
+ *
+ * @return SUCCESS, or FAILURE on invalid input.
+ */
+DLL_EXPORT int compute_EMA_interleaved(const double *prices, size_t stride, int symbols, int length, int window,
+                                       double *EMA_Values);
+
+/**
+ * @brief Computes the RSI of many symbols stored time-major, one symbol per SIMD lane.
+ *
+ * Same layout and parameters as compute_EMA_interleaved; each symbol receives the
+ * `length - window` values of compute_RSI_into.
+ */
+DLL_EXPORT int compute_RSI_interleaved(const double *prices, size_t stride, int symbols, int length, int window,
+                                       double *RSI_Values);
+
+/**
+ * @brief Computes the MACD of many symbols stored time-major, one symbol per SIMD lane.
+ *
+ * Same layout as compute_EMA_interleaved; each symbol receives the values of
+ * compute_MACD_periods_into in the three output matrices. `histogram_Values` may be NULL.
+ */
+DLL_EXPORT int compute_MACD_interleaved(const double *prices, size_t stride, int symbols, int length,
+                                        int fast_period, int slow_period, int signal_period,
+                                        double *MACD_Values, double *signal_line_Values, double *histogram_Values);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PANEL_H
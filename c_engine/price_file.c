@@ -0,0 +1,229 @@
+/**
+ * price_file.c
+ * ------------
+ * Reads and writes the columnar binary price files described in price_file.h.
+ *
+ * Files are mapped read-only, so opening one costs a header check regardless of its size
+ * and the pages are shared between every process serving the same data. Windows builds
+ * read the file into memory instead.
+ */
+
+#include "price_file.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <string.h>
+#include <limits.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+_Static_assert(sizeof(PriceFileHeader) == PRICE_FILE_HEADER_SIZE, "price file header must be 64 bytes");
+
+#define BYTE_ORDER_SWAPPED 0x04030201u // PRICE_FILE_BYTE_ORDER written on a machine of the other byte order
+
+/**
+ * Maps (or, on Windows, reads) the whole file. Returns NULL on failure.
+ */
+static void *map_file(const char *path, size_t *size)
+{
+#ifdef _WIN32
+    FILE *f = fopen(path, "rb");
+    if (!f)
+        return NULL;
+    void *data = NULL;
+    if (fseek(f, 0, SEEK_END) == 0)
+    {
+        long end = ftell(f);
+        if (end > 0 && fseek(f, 0, SEEK_SET) == 0)
+        {
+            data = malloc((size_t)end);
+            if (data && fread(data, 1, (size_t)end, f) != (size_t)end)
+            {
+                free(data);
+                data = NULL;
+            }
+            *size = (size_t)end;
+        }
+    }
+    fclose(f);
+    return data;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+    struct stat info;
+    void *data = NULL;
+    if (fstat(fd, &info) == 0 && info.st_size > 0)
+    {
+        data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        if (data == MAP_FAILED)
+            data = NULL;
+        *size = (size_t)info.st_size;
+    }
+    close(fd); // the mapping stays valid without the descriptor
+    return data;
+#endif
+}
+
+static void unmap_file(void *data, size_t size)
+{
+#ifdef _WIN32
+    (void)size;
+    free(data);
+#else
+    munmap(data, size);
+#endif
+}
+
+DLL_EXPORT PriceFile *open_price_file(const char *path)
+{
+    if (!path)
+    {
+        fprintf(stderr, "Invalid input.\n");
+        return NULL;
+    }
+
+    size_t size = 0;
+    unsigned char *data = map_file(path, &size);
+    if (!data)
+    {
+        fprintf(stderr, "Could not open %s. %s.\n", path, strerror(errno));
+        return NULL;
+    }
+
+    PriceFileHeader header;
+    int valid = size >= PRICE_FILE_HEADER_SIZE;
+    if (valid)
+    {
+        memcpy(&header, data, sizeof(header));
+        if (header.byte_order == BYTE_ORDER_SWAPPED)
+        {
+            fprintf(stderr, "Price file %s was written with the other byte order.\n", path);
+            unmap_file(data, size);
+            return NULL;
+        }
+        // a file without the marker still fails the version check on a machine of the other byte order
+        valid = memcmp(header.magic, PRICE_FILE_MAGIC, sizeof(header.magic)) == 0 &&
+                header.version == PRICE_FILE_VERSION && header.header_size == PRICE_FILE_HEADER_SIZE &&
+                (header.byte_order == PRICE_FILE_BYTE_ORDER || header.byte_order == 0) && header.rows <= INT_MAX &&
+                size == PRICE_FILE_HEADER_SIZE + PRICE_FILE_COLUMNS * sizeof(double) * header.rows;
+    }
+    if (!valid)
+    {
+        fprintf(stderr, "Invalid price file %s.\n", path);
+        unmap_file(data, size);
+        return NULL;
+    }
+
+    PriceFile *file = malloc(sizeof(PriceFile));
+    if (!file)
+    {
+        fprintf(stderr, "Malloc failed. %s.\n", strerror(errno));
+        unmap_file(data, size);
+        return NULL;
+    }
+
+    size_t column_bytes = sizeof(double) * header.rows;
+    const unsigned char *columns = data + PRICE_FILE_HEADER_SIZE;
+    file->rows = (int)header.rows;
+    memcpy(file->symbol, header.symbol, PRICE_FILE_SYMBOL_SIZE);
+    file->symbol[PRICE_FILE_SYMBOL_SIZE] = '\0';
+    file->timestamps = (const int64_t *)columns;
+    file->open = (const double *)(columns + column_bytes);
+    file->high = (const double *)(columns + 2 * column_bytes);
+    file->low = (const double *)(columns + 3 * column_bytes);
+    file->close = (const double *)(columns + 4 * column_bytes);
+    file->volume = (const double *)(columns + 5 * column_bytes);
+    file->mapping = data;
+    file->mapping_size = size;
+    return file;
+}
+
+DLL_EXPORT void close_price_file(PriceFile *file)
+{
+    if (!file)
+        return;
+    unmap_file(file->mapping, file->mapping_size);
+    free(file);
+}
+
+/**
+ * Index of the first bar whose timestamp is >= `bound` (or > `bound` when `after` is set).
+ */
+static int lower_bound(const PriceFile *file, int64_t bound, int after)
+{
+    int low = 0;
+    int high = file->rows;
+    while (low < high)
+    {
+        int middle = low + (high - low) / 2;
+        int64_t t = file->timestamps[middle];
+        if (t < bound || (after && t == bound))
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return low;
+}
+
+DLL_EXPORT int price_file_range(const PriceFile *file, int64_t start, int64_t end, int *first)
+{
+    if (!file || !first)
+    {
+        fprintf(stderr, "Invalid input.\n");
+        return -1;
+    }
+
+    int begin = lower_bound(file, start, 0);
+    int stop = lower_bound(file, end, 1);
+    *first = begin;
+    return (stop > begin) ? stop - begin : 0;
+}
+
+DLL_EXPORT int write_price_file(const char *path, const char *symbol, int rows, const int64_t *timestamps,
+                                const double *open, const double *high, const double *low,
+                                const double *close, const double *volume)
+{
+    if (!path || !symbol || rows < 0 || !timestamps || !open || !high || !low || !close || !volume)
+    {
+        fprintf(stderr, "Invalid input.\n");
+        return FAILURE;
+    }
+
+    PriceFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, PRICE_FILE_MAGIC, sizeof(header.magic));
+    header.version = PRICE_FILE_VERSION;
+    header.header_size = PRICE_FILE_HEADER_SIZE;
+    header.rows = (uint64_t)rows;
+    header.byte_order = PRICE_FILE_BYTE_ORDER;
+    size_t symbol_length = strlen(symbol);
+    memcpy(header.symbol, symbol, (symbol_length < PRICE_FILE_SYMBOL_SIZE) ? symbol_length : PRICE_FILE_SYMBOL_SIZE);
+
+    FILE *f = fopen(path, "wb");
+    if (!f)
+    {
+        fprintf(stderr, "Could not open %s. %s.\n", path, strerror(errno));
+        return FAILURE;
+    }
+
+    const void *columns[PRICE_FILE_COLUMNS] = {timestamps, open, high, low, close, volume};
+    int ok = fwrite(&header, sizeof(header), 1, f) == 1;
+    for (int c = 0; c < PRICE_FILE_COLUMNS && ok; c++)
+    {
+        ok = fwrite(columns[c], sizeof(double), (size_t)rows, f) == (size_t)rows;
+    }
+    if (fclose(f) != 0)
+        ok = 0;
+    if (!ok)
+    {
+        fprintf(stderr, "Could not write %s. %s.\n", path, strerror(errno));
+        return FAILURE;
+    }
+    return SUCCESS;
+}
@@ -0,0 +1,118 @@
+/**
+ * price_file.h
+ * ------------
+ * Declarations for the columnar binary price file format.
+ *
+ * A price file holds one symbol's bars as contiguous columns, so opening it is a single
+ * mmap and every column can be passed to the indicator functions as a plain pointer,
+ * without parsing or copying. Values are stored in the byte order of the machine that
+ * wrote the file, which the header records; since the columns are used in place,
+ * open_price_file() rejects a file of the other byte order instead of swapping it.
+ * Layout:
+ *
+ *   offset                  contents
+ *   0                       PriceFileHeader (PRICE_FILE_HEADER_SIZE bytes)
+ *   64                      timestamps: rows x int64, seconds since the Unix epoch, ascending
+ *   64 + 8 * rows * k       open, high, low, close, volume for k = 1 .. 5: rows x float64 each
+ *
+ * The file size is exactly 64 + 48 * rows bytes, and every column is 8-byte aligned.
+ */
+
+#ifndef PRICE_FILE_H
+#define PRICE_FILE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "indicators.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PRICE_FILE_MAGIC "PRICECOL"
+#define PRICE_FILE_VERSION 1
+#define PRICE_FILE_HEADER_SIZE 64
+#define PRICE_FILE_SYMBOL_SIZE 16
+#define PRICE_FILE_COLUMNS 6 // timestamps, open, high, low, close, volume
+#define PRICE_FILE_BYTE_ORDER 0x01020304u // stored as a native uint32_t, so it reads back swapped across byte orders
+
+/**
+ * @brief On-disk header of a price file.
+ */
+typedef struct
+{
+    char magic[8];       // PRICE_FILE_MAGIC, not NUL-terminated
+    uint32_t version;    // PRICE_FILE_VERSION
+    uint32_t header_size; // PRICE_FILE_HEADER_SIZE; columns start here
+    uint64_t rows;
+    char symbol[PRICE_FILE_SYMBOL_SIZE]; // NUL-padded
+    uint32_t byte_order; // PRICE_FILE_BYTE_ORDER; 0 in files written before it was recorded
+    uint8_t reserved[20];
+} PriceFileHeader;
+
+/**
+ * @brief An open price file. The column pointers point into the mapped file and stay
+ *        valid until close_price_file().
+ */
+typedef struct
+{
+    int rows;
+    char symbol[PRICE_FILE_SYMBOL_SIZE + 1];
+    const int64_t *timestamps;
+    const double *open;
+    const double *high;
+    const double *low;
+    const double *close;
+    const double *volume;
+    void *mapping;       // start of the mapped file (the header)
+    size_t mapping_size; // bytes mapped
+} PriceFile;
+
+/**
+ * @brief Maps a price file read-only and validates its header and size.
+ *
+ * @param path Path of the file.
+ *
+ * @return Pointer to the open file, or NULL if it cannot be opened or is not a valid
+ *         price file (wrong magic, version, byte order or size, or more than INT_MAX
+ *         rows).
+ *
+ * @note Release the file with close_price_file().
+ */
+DLL_EXPORT PriceFile *open_price_file(const char *path);
+
+/**
+ * @brief Unmaps the file and frees `file`. NULL is ignored.
+ */
+DLL_EXPORT void close_price_file(PriceFile *file);
+
+/**
+ * @brief Finds the bars with start <= timestamp <= end by binary search.
+ *
+ * @param file  The open file.
+ * @param start First timestamp of the range, in seconds since the Unix epoch.
+ * @param end   Last timestamp of the range (inclusive).
+ * @param first Receives the index of the first bar in the range.
+ *
+ * @return Number of bars in the range (possibly 0), or -1 on invalid input.
+ */
+DLL_EXPORT int price_file_range(const PriceFile *file, int64_t start, int64_t end, int *first);
+
+/**
+ * @brief Writes a price file from column arrays of `rows` values each.
+ *
+ * @param path       Path of the file to create or replace.
+ * @param symbol     Ticker, truncated to PRICE_FILE_SYMBOL_SIZE bytes.
+ * @param timestamps Seconds since the Unix epoch, ascending.
+ *
+ * @return SUCCESS, or FAILURE on invalid input or I/O error.
+ */
+DLL_EXPORT int write_price_file(const char *path, const char *symbol, int rows, const int64_t *timestamps,
+                                const double *open, const double *high, const double *low,
+                                const double *close, const double *volume);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PRICE_FILE_H
@@ -0,0 +1,86 @@
+/**
+ * series_hash.c
+ * -------------
+ * A fast non-cryptographic hash over double arrays, built from the xxHash64 round and
+ * avalanche steps.
+ */
+
+#include "series_hash.h"
+#include <stdio.h>
+#include <string.h>
+
+#define PRIME_1 0x9E3779B185EBCA87ULL
+#define PRIME_2 0xC2B2AE3D27D4EB4FULL
+#define PRIME_3 0x165667B19E3779F9ULL
+#define PRIME_4 0x85EBCA77C2B2AE63ULL
+#define PRIME_5 0x27D4EB2F165667C5ULL
+
+static inline uint64_t rotate_left(uint64_t x, int bits)
+{
+    return (x << bits) | (x >> (64 - bits));
+}
+
+static inline uint64_t round_step(uint64_t accumulator, uint64_t word)
+{
+    accumulator += word * PRIME_2;
+    return rotate_left(accumulator, 31) * PRIME_1;
+}
+
+static inline uint64_t merge_step(uint64_t hash, uint64_t accumulator)
+{
+    hash ^= round_step(0, accumulator);
+    return hash * PRIME_1 + PRIME_4;
+}
+
+static inline uint64_t load_word(const double *value)
+{
+    uint64_t word;
+    memcpy(&word, value, sizeof(word)); // bit pattern, without aliasing a double as an integer
+    return word;
+}
+
+DLL_EXPORT uint64_t hash_series(const double *values, int length, uint64_t seed)
+{
+    if (length < 0 || (!values && length > 0))
+    {
+        fprintf(stderr, "Invalid input.\n");
+        return 0;
+    }
+
+    int i = 0;
+    uint64_t hash;
+    if (length >= 4)
+    {
+        uint64_t lanes[4] = {seed + PRIME_1 + PRIME_2, seed + PRIME_2, seed, seed - PRIME_1};
+        for (; i + 4 <= length; i += 4)
+        {
+            lanes[0] = round_step(lanes[0], load_word(values + i));
+            lanes[1] = round_step(lanes[1], load_word(values + i + 1));
+            lanes[2] = round_step(lanes[2], load_word(values + i + 2));
+            lanes[3] = round_step(lanes[3], load_word(values + i + 3));
+        }
+        hash = rotate_left(lanes[0], 1) + rotate_left(lanes[1], 7) + rotate_left(lanes[2], 12) +
+               rotate_left(lanes[3], 18);
+        for (int lane = 0; lane < 4; lane++)
+            hash = merge_step(hash, lanes[lane]);
+    }
+    else
+    {
+        hash = seed + PRIME_5;
+    }
+
+    hash += (uint64_t)length * sizeof(double);
+    for (; i < length; i++)
+    {
+        hash ^= round_step(0, load_word(values + i));
+        hash = rotate_left(hash, 27) * PRIME_1 + PRIME_4;
+    }
+
+    // avalanche, so every input bit affects every output bit
+    hash ^= hash >> 33;
+    hash *= PRIME_2;
+    hash ^= hash >> 29;
+    hash *= PRIME_3;
+    hash ^= hash >> 32;
+    return hash;
+}
@@ -0,0 +1,41 @@
+/**
+ * series_hash.h
+ * -------------
+ * Declarations for fingerprinting input series, used by the backend to key cached results.
+ */
+
+#ifndef SERIES_HASH_H
+#define SERIES_HASH_H
+
+#include <stdint.h>
+#include "indicators.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Computes a 64-bit hash of a series' bytes.
+ *
+ * The values are hashed as raw IEEE bit patterns, so identical series always hash alike
+ * (0.0 and -0.0 are different inputs, as are NaN payloads). Different series may collide.
+ * Four independent accumulators keep several multiplies in flight, so hashing a series
+ * costs a fraction of computing even the cheapest indicator over it.
+ *
+ * @param values Array of `length` values; may be NULL when `length` is 0.
+ * @param length Number of values.
+ * @param seed   Starting state, e.g. the hash of another series to fingerprint several
+ *               series together.
+ *
+ * @return The hash, or 0 on invalid input.
+ *
+ * @note Not a cryptographic hash, and not collision resistant: callers that key results by
+ *       it must compare the series on a match (the backend's result cache does).
+ */
+DLL_EXPORT uint64_t hash_series(const double *values, int length, uint64_t seed);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SERIES_HASH_H
@@ -0,0 +1,349 @@
+/**
+ * simd.c
+ * ------
+ * AVX2 and AVX-512 versions of the rolling window kernels, selected at runtime.
+ *
+ * Each ISA-specific function is compiled with a GCC/Clang `target` attribute, so a single
+ * indicators.so built with plain flags contains every version; the CPU is queried on each
+ * call (a cached flag read) and the widest supported kernel runs. On other compilers or
+ * architectures everything falls back to the scalar kernels in indicators.c.
+ *
+ * Within a resync block of `window` outputs, the window sums are S0 + prefix_sum(d) where
+ * d[k] = prices[k + window - 1] - prices[k - 1]; the prefix sum is evaluated in-register
+ * a vector at a time, with the running total carried between vectors. The sum of squared
+ * deviations is slid the same way once the means are known.
+ */
+
+#include "simd.h"
+#include <math.h>
+
+#define SIMD_MIN_WINDOW 16    // shorter windows leave too few outputs per resync block to fill vectors
+#define AVX512_MIN_WINDOW 32  // below this the 4-lane kernel wastes less on the scalar tail
+
+static int simd_level_cap = SIMD_AVX512; // highest level set_simd_level() allows
+static int rolling_simd_enabled = 1;     // set_rolling_simd(); off makes batch and streams bit-identical
+
+static int detect_simd_level(void)
+{
+#ifdef SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return SIMD_AVX512;
+    if (__builtin_cpu_supports("avx2"))
+        return SIMD_AVX2;
+#endif
+    return SIMD_SCALAR;
+}
+
+DLL_EXPORT int get_simd_level(void)
+{
+    int detected = detect_simd_level();
+    return (detected < simd_level_cap) ? detected : simd_level_cap;
+}
+
+DLL_EXPORT int set_simd_level(int level)
+{
+    if (level < SIMD_SCALAR)
+        level = SIMD_SCALAR;
+    if (level > SIMD_AVX512)
+        level = SIMD_AVX512;
+    simd_level_cap = level;
+    return get_simd_level();
+}
+
+DLL_EXPORT int set_rolling_simd(int enabled)
+{
+    int previous = rolling_simd_enabled;
+    rolling_simd_enabled = (enabled != 0);
+    return previous;
+}
+
+DLL_EXPORT int get_rolling_simd(void)
+{
+    return rolling_simd_enabled;
+}
+
+#ifdef SIMD_X86
+
+/*
+ * Scalar pieces of the rolling kernel, identical to the loop body of rolling_mean_std().
+ * Used for the first output of each block and the tail that does not fill a vector.
+ * They are force-inlined so they are compiled with the caller's VEX encoding; a call to
+ * legacy SSE code with dirty upper registers stalls on every instruction, even at -O0.
+ */
+static inline __attribute__((always_inline)) void emit_outputs(int i, double mean, double m2, int window, double band_width,
+                         double *means, double *std_devs, double *top, double *bottom)
+{
+    double std_dev = (m2 > 0) ? sqrt(m2 / window) : 0.0;
+    if (means)
+        means[i] = mean;
+    if (std_devs)
+        std_devs[i] = std_dev;
+    if (top)
+        top[i] = mean + band_width * std_dev;
+    if (bottom)
+        bottom[i] = mean - band_width * std_dev;
+}
+
+static inline __attribute__((always_inline)) void scalar_step(const double *prices, int i, int window, double *sum, double *mean, double *m2)
+{
+    double x_new = prices[i + window - 1];
+    double x_old = prices[i - 1];
+    double prev_mean = *mean;
+    *sum += x_new - x_old;
+    *mean = *sum / window;
+    *m2 += (x_new - x_old) * (x_new - *mean + x_old - prev_mean);
+}
+
+/* ---------------------------------------------------------------- AVX2 (4 lanes) */
+
+__attribute__((target("avx2"))) static double sum_avx2(const double *x, int n)
+{
+    __m256d acc = _mm256_setzero_pd();
+    int j = 0;
+    for (; j + 4 <= n; j += 4)
+    {
+        acc = _mm256_add_pd(acc, _mm256_loadu_pd(x + j));
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, acc);
+    double sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    for (; j < n; j++)
+    {
+        sum += x[j];
+    }
+    return sum;
+}
+
+__attribute__((target("avx2"))) static double m2_avx2(const double *x, int n, double mean)
+{
+    __m256d mean_v = _mm256_set1_pd(mean);
+    __m256d acc = _mm256_setzero_pd();
+    int j = 0;
+    for (; j + 4 <= n; j += 4)
+    {
+        __m256d difference = _mm256_sub_pd(_mm256_loadu_pd(x + j), mean_v);
+        acc = _mm256_add_pd(acc, _mm256_mul_pd(difference, difference));
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, acc);
+    double m2 = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    for (; j < n; j++)
+    {
+        double difference = x[j] - mean;
+        m2 += difference * difference;
+    }
+    return m2;
+}
+
+// inclusive prefix sum of the 4 lanes
+__attribute__((target("avx2"))) static inline __m256d scan_avx2(__m256d v)
+{
+    __m256d zero = _mm256_setzero_pd();
+    v = _mm256_add_pd(v, _mm256_blend_pd(_mm256_permute4x64_pd(v, _MM_SHUFFLE(2, 1, 0, 0)), zero, 0x1));
+    v = _mm256_add_pd(v, _mm256_blend_pd(_mm256_permute4x64_pd(v, _MM_SHUFFLE(1, 0, 0, 0)), zero, 0x3));
+    return v;
+}
+
+__attribute__((target("avx2"))) static inline double last_lane_avx2(__m256d v)
+{
+    return _mm256_cvtsd_f64(_mm256_permute4x64_pd(v, _MM_SHUFFLE(3, 3, 3, 3)));
+}
+
+__attribute__((target("avx2"))) static void rolling_avx2(const double *prices, int result_length, int window, double band_width,
+                                                         double *means, double *std_devs, double *top, double *bottom)
+{
+    int want_spread = std_devs || top || bottom;
+    __m256d window_v = _mm256_set1_pd((double)window);
+    __m256d width_v = _mm256_set1_pd(band_width);
+    __m256d zero = _mm256_setzero_pd();
+
+    for (int start = 0; start < result_length; start += window)
+    {
+        int end = (result_length - start < window) ? result_length : start + window;
+
+        // exact resync at the start of every block
+        double sum = sum_avx2(prices + start, window);
+        double mean = sum / window;
+        double m2 = want_spread ? m2_avx2(prices + start, window, mean) : 0.0;
+        emit_outputs(start, mean, m2, window, band_width, means, std_devs, top, bottom);
+
+        int i = start + 1;
+        for (; i + 4 <= end; i += 4)
+        {
+            __m256d x_new = _mm256_loadu_pd(prices + i + window - 1);
+            __m256d x_old = _mm256_loadu_pd(prices + i - 1);
+            __m256d change = _mm256_sub_pd(x_new, x_old);
+            __m256d sums = _mm256_add_pd(scan_avx2(change), _mm256_set1_pd(sum));
+            __m256d means_v = _mm256_div_pd(sums, window_v);
+            sum = last_lane_avx2(sums);
+            if (means)
+                _mm256_storeu_pd(means + i, means_v);
+
+            if (want_spread)
+            {
+                // previous mean of every lane: [mean, means_v[0], means_v[1], means_v[2]]
+                __m256d prev_means = _mm256_blend_pd(_mm256_permute4x64_pd(means_v, _MM_SHUFFLE(2, 1, 0, 0)), _mm256_set1_pd(mean), 0x1);
+                __m256d spread = _mm256_sub_pd(_mm256_add_pd(_mm256_sub_pd(x_new, means_v), x_old), prev_means);
+                __m256d m2s = _mm256_add_pd(scan_avx2(_mm256_mul_pd(change, spread)), _mm256_set1_pd(m2));
+                m2 = last_lane_avx2(m2s);
+
+                __m256d sd = _mm256_sqrt_pd(_mm256_div_pd(_mm256_max_pd(m2s, zero), window_v));
+                if (std_devs)
+                    _mm256_storeu_pd(std_devs + i, sd);
+                if (top)
+                    _mm256_storeu_pd(top + i, _mm256_add_pd(means_v, _mm256_mul_pd(width_v, sd)));
+                if (bottom)
+                    _mm256_storeu_pd(bottom + i, _mm256_sub_pd(means_v, _mm256_mul_pd(width_v, sd)));
+            }
+            mean = last_lane_avx2(means_v);
+        }
+        for (; i < end; i++)
+        {
+            scalar_step(prices, i, window, &sum, &mean, &m2);
+            emit_outputs(i, mean, m2, window, band_width, means, std_devs, top, bottom);
+        }
+    }
+}
+
+/* ------------------------------------------------------------- AVX-512 (8 lanes) */
+
+__attribute__((target("avx512f"))) static double sum_avx512(const double *x, int n)
+{
+    __m512d acc = _mm512_setzero_pd();
+    int j = 0;
+    for (; j + 8 <= n; j += 8)
+    {
+        acc = _mm512_add_pd(acc, _mm512_loadu_pd(x + j));
+    }
+    double sum = _mm512_reduce_add_pd(acc);
+    for (; j < n; j++)
+    {
+        sum += x[j];
+    }
+    return sum;
+}
+
+__attribute__((target("avx512f"))) static double m2_avx512(const double *x, int n, double mean)
+{
+    __m512d mean_v = _mm512_set1_pd(mean);
+    __m512d acc = _mm512_setzero_pd();
+    int j = 0;
+    for (; j + 8 <= n; j += 8)
+    {
+        __m512d difference = _mm512_sub_pd(_mm512_loadu_pd(x + j), mean_v);
+        acc = _mm512_add_pd(acc, _mm512_mul_pd(difference, difference));
+    }
+    double m2 = _mm512_reduce_add_pd(acc);
+    for (; j < n; j++)
+    {
+        double difference = x[j] - mean;
+        m2 += difference * difference;
+    }
+    return m2;
+}
+
+// inclusive prefix sum of the 8 lanes
+__attribute__((target("avx512f"))) static inline __m512d scan_avx512(__m512d v)
+{
+    v = _mm512_add_pd(v, _mm512_maskz_permutexvar_pd(0xFE, _mm512_set_epi64(6, 5, 4, 3, 2, 1, 0, 0), v));
+    v = _mm512_add_pd(v, _mm512_maskz_permutexvar_pd(0xFC, _mm512_set_epi64(5, 4, 3, 2, 1, 0, 0, 0), v));
+    v = _mm512_add_pd(v, _mm512_maskz_permutexvar_pd(0xF0, _mm512_set_epi64(3, 2, 1, 0, 0, 0, 0, 0), v));
+    return v;
+}
+
+__attribute__((target("avx512f"))) static inline double last_lane_avx512(__m512d v)
+{
+    return _mm512_cvtsd_f64(_mm512_permutexvar_pd(_mm512_set1_epi64(7), v));
+}
+
+__attribute__((target("avx512f"))) static void rolling_avx512(const double *prices, int result_length, int window, double band_width,
+                                                              double *means, double *std_devs, double *top, double *bottom)
+{
+    int want_spread = std_devs || top || bottom;
+    __m512d window_v = _mm512_set1_pd((double)window);
+    __m512d width_v = _mm512_set1_pd(band_width);
+    __m512d zero = _mm512_setzero_pd();
+    __m512i shift_one = _mm512_set_epi64(6, 5, 4, 3, 2, 1, 0, 0);
+
+    for (int start = 0; start < result_length; start += window)
+    {
+        int end = (result_length - start < window) ? result_length : start + window;
+
+        // exact resync at the start of every block
+        double sum = sum_avx512(prices + start, window);
+        double mean = sum / window;
+        double m2 = want_spread ? m2_avx512(prices + start, window, mean) : 0.0;
+        emit_outputs(start, mean, m2, window, band_width, means, std_devs, top, bottom);
+
+        int i = start + 1;
+        for (; i + 8 <= end; i += 8)
+        {
+            __m512d x_new = _mm512_loadu_pd(prices + i + window - 1);
+            __m512d x_old = _mm512_loadu_pd(prices + i - 1);
+            __m512d change = _mm512_sub_pd(x_new, x_old);
+            __m512d sums = _mm512_add_pd(scan_avx512(change), _mm512_set1_pd(sum));
+            __m512d means_v = _mm512_div_pd(sums, window_v);
+            sum = last_lane_avx512(sums);
+            if (means)
+                _mm512_storeu_pd(means + i, means_v);
+
+            if (want_spread)
+            {
+                // previous mean of every lane: [mean, means_v[0], ..., means_v[6]]
+                __m512d prev_means = _mm512_mask_permutexvar_pd(_mm512_set1_pd(mean), 0xFE, shift_one, means_v);
+                __m512d spread = _mm512_sub_pd(_mm512_add_pd(_mm512_sub_pd(x_new, means_v), x_old), prev_means);
+                __m512d m2s = _mm512_add_pd(scan_avx512(_mm512_mul_pd(change, spread)), _mm512_set1_pd(m2));
+                m2 = last_lane_avx512(m2s);
+
+                __m512d sd = _mm512_sqrt_pd(_mm512_div_pd(_mm512_max_pd(m2s, zero), window_v));
+                if (std_devs)
+                    _mm512_storeu_pd(std_devs + i, sd);
+                if (top)
+                    _mm512_storeu_pd(top + i, _mm512_add_pd(means_v, _mm512_mul_pd(width_v, sd)));
+                if (bottom)
+                    _mm512_storeu_pd(bottom + i, _mm512_sub_pd(means_v, _mm512_mul_pd(width_v, sd)));
+            }
+            mean = last_lane_avx512(means_v);
+        }
+        for (; i < end; i++)
+        {
+            scalar_step(prices, i, window, &sum, &mean, &m2);
+            emit_outputs(i, mean, m2, window, band_width, means, std_devs, top, bottom);
+        }
+    }
+}
+
+#endif // SIMD_X86
+
+int rolling_mean_std_simd(const double *prices, int result_length, int window, double band_width,
+                          double *means, double *std_devs, double *top, double *bottom)
+{
+    if (!rolling_simd_enabled || window < SIMD_MIN_WINDOW)
+        return 0;
+
+#ifdef SIMD_X86
+    switch (get_simd_level())
+    {
+    case SIMD_AVX512:
+        if (window >= AVX512_MIN_WINDOW)
+        {
+            rolling_avx512(prices, result_length, window, band_width, means, std_devs, top, bottom);
+            return 1;
+        }
+        // fall through
+    case SIMD_AVX2:
+        rolling_avx2(prices, result_length, window, band_width, means, std_devs, top, bottom);
+        return 1;
+    }
+#else
+    (void)prices;
+    (void)result_length;
+    (void)band_width;
+    (void)means;
+    (void)std_devs;
+    (void)top;
+    (void)bottom;
+#endif
+    return 0;
+}
@@ -0,0 +1,34 @@
+/**
+ * simd.h
+ * ------
+ * Internal interface between the scalar kernels and their vectorized versions.
+ * Not part of the public API; see get_simd_level() / set_simd_level() in indicators.h.
+ */
+
+#ifndef SIMD_H
+#define SIMD_H
+
+#include "indicators.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_X86 1 // AVX2 / AVX-512 kernels are compiled in and chosen at runtime
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Vectorized rolling mean / standard deviation, dispatched on the active SIMD level.
+ *
+ * Same contract as the scalar rolling_mean_std() in indicators.c: any output may be NULL,
+ * and `top`/`bottom` receive mean +/- band_width * std_dev. Window sums are still
+ * recomputed exactly every `window` outputs, but the values in between are formed with
+ * an in-register prefix sum, so results can differ from the scalar kernel in the last
+ * few bits (see SIMD_RELATIVE_TOLERANCE).
+ *
+ * @return 1 if the vectorized kernel ran, 0 if the caller should use the scalar kernel
+ *         (disabled with set_rolling_simd(), no SIMD support, SIMD disabled, or a window
+ *         too small to benefit).
+ */
+int rolling_mean_std_simd(const double *prices, int result_length, int window, double band_width,
+                          double *means, double *std_devs, double *top, double *bottom);
+
+#endif // SIMD_H
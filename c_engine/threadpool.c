@@ -0,0 +1,337 @@
+/**
+ * threadpool.c
+ * ------------
+ * A small pthreads worker pool with work stealing, and the parallel panel driver built on it.
+ *
+ * Each job's task indices are split into one contiguous range per worker. Workers take
+ * tasks from the front of their own range; once it is empty they steal the back half of
+ * another worker's range, so uneven tasks (e.g. symbols with very different history
+ * lengths) still keep every core busy.
+ */
+
+#include "threadpool.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+
+#define PANEL_TASK_SYMBOLS 64 // symbols per parallel panel task; a multiple of the column gather block
+
+typedef struct
+{
+    pthread_mutex_t lock;
+    int next; // first task not yet taken
+    int end;  // one past the last task of the range
+} TaskRange;
+
+typedef struct
+{
+    ThreadPool *pool;
+    int index;
+} WorkerSlot;
+
+struct ThreadPool
+{
+    int size;           // workers, including the thread that submits a job
+    pthread_t *threads; // size - 1 background threads
+    WorkerSlot *slots;
+    TaskRange *ranges; // one per worker
+
+    pthread_mutex_t submit_lock; // serializes run_thread_pool() callers
+    pthread_mutex_t lock;        // guards the fields below
+    pthread_cond_t work_ready;
+    pthread_cond_t work_done;
+    unsigned long generation; // bumped for every job
+    int busy_workers;         // background workers still running the current job
+    int shutdown;
+    PoolTask task;
+    void *context;
+};
+
+/**
+ * Takes the next task from the worker's own range, or returns -1 if it is empty.
+ */
+static int take_task(ThreadPool *pool, int worker)
+{
+    TaskRange *range = &pool->ranges[worker];
+    int task = -1;
+    pthread_mutex_lock(&range->lock);
+    if (range->next < range->end)
+        task = range->next++;
+    pthread_mutex_unlock(&range->lock);
+    return task;
+}
+
+/**
+ * Moves the back half of another worker's remaining tasks into the worker's own range.
+ * Returns 1 if anything was stolen, 0 if every other range is empty.
+ */
+static int steal_tasks(ThreadPool *pool, int worker)
+{
+    for (int offset = 1; offset < pool->size; offset++)
+    {
+        TaskRange *victim = &pool->ranges[(worker + offset) % pool->size];
+
+        pthread_mutex_lock(&victim->lock);
+        int remaining = victim->end - victim->next;
+        int end = victim->end;
+        int take = (remaining + 1) / 2;
+        victim->end -= take;
+        pthread_mutex_unlock(&victim->lock);
+
+        if (take > 0)
+        {
+            TaskRange *own = &pool->ranges[worker];
+            pthread_mutex_lock(&own->lock);
+            own->next = end - take;
+            own->end = end;
+            pthread_mutex_unlock(&own->lock);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void drain_tasks(ThreadPool *pool, int worker)
+{
+    for (;;)
+    {
+        int task = take_task(pool, worker);
+        if (task >= 0)
+            pool->task(pool->context, task, worker);
+        else if (!steal_tasks(pool, worker))
+            return;
+    }
+}
+
+static void *worker_main(void *arg)
+{
+    WorkerSlot *slot = arg;
+    ThreadPool *pool = slot->pool;
+    unsigned long seen = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    for (;;)
+    {
+        while (!pool->shutdown && pool->generation == seen)
+        {
+            pthread_cond_wait(&pool->work_ready, &pool->lock);
+        }
+        if (pool->shutdown)
+            break;
+        seen = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+
+        drain_tasks(pool, slot->index);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->busy_workers == 0)
+            pthread_cond_signal(&pool->work_done);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+/**
+ * Stops and joins the workers that were started (`threads` - 1; worker 0 is never a thread of
+ * its own) and releases everything else init_thread_pool() created, including the first
+ * `range_locks` per-worker range locks. Shared by cleanup_thread_pool() and the error paths of
+ * init_thread_pool(), which may fail with only part of the workers set up.
+ */
+static void destroy_thread_pool(ThreadPool *pool, int threads, int range_locks)
+{
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = 1;
+    pthread_cond_broadcast(&pool->work_ready);
+    pthread_mutex_unlock(&pool->lock);
+    for (int w = 1; w < threads; w++)
+    {
+        pthread_join(pool->threads[w - 1], NULL);
+    }
+
+    for (int w = 0; w < range_locks; w++)
+    {
+        pthread_mutex_destroy(&pool->ranges[w].lock);
+    }
+    pthread_cond_destroy(&pool->work_done);
+    pthread_cond_destroy(&pool->work_ready);
+    pthread_mutex_destroy(&pool->lock);
+    pthread_mutex_destroy(&pool->submit_lock);
+    free(pool->threads);
+    free(pool->slots);
+    free(pool->ranges);
+    free(pool);
+}
+
+DLL_EXPORT ThreadPool *init_thread_pool(int threads)
+{
+    if (threads <= 0)
+    {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = (cpus > 0) ? (int)cpus : 1;
+    }
+
+    ThreadPool *pool = calloc(1, sizeof(ThreadPool));
+    if (!pool)
+    {
+        fprintf(stderr, "Malloc failed. %s.\n", strerror(errno));
+        return NULL;
+    }
+    pool->size = threads;
+    pool->threads = malloc(sizeof(pthread_t) * threads);
+    pool->slots = malloc(sizeof(WorkerSlot) * threads);
+    pool->ranges = malloc(sizeof(TaskRange) * threads);
+    if (!pool->threads || !pool->slots || !pool->ranges)
+    {
+        free(pool->threads);
+        free(pool->slots);
+        free(pool->ranges);
+        free(pool);
+        fprintf(stderr, "Malloc failed. %s.\n", strerror(errno));
+        return NULL;
+    }
+
+    pthread_mutex_init(&pool->submit_lock, NULL);
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_ready, NULL);
+    pthread_cond_init(&pool->work_done, NULL);
+    for (int w = 0; w < threads; w++)
+    {
+        int error = pthread_mutex_init(&pool->ranges[w].lock, NULL);
+        if (error)
+        {
+            fprintf(stderr, "Mutex creation failed. %s.\n", strerror(error));
+            destroy_thread_pool(pool, 1, w); // no worker thread is running yet
+            return NULL;
+        }
+        pool->ranges[w].next = 0;
+        pool->ranges[w].end = 0;
+        pool->slots[w].pool = pool;
+        pool->slots[w].index = w;
+    }
+
+    // worker 0 is whichever thread calls run_thread_pool()
+    for (int w = 1; w < threads; w++)
+    {
+        int error = pthread_create(&pool->threads[w - 1], NULL, worker_main, &pool->slots[w]);
+        if (error)
+        {
+            fprintf(stderr, "Thread creation failed. %s.\n", strerror(error));
+            destroy_thread_pool(pool, w, threads); // join the w - 1 threads started; every range lock exists
+            return NULL;
+        }
+    }
+    return pool;
+}
+
+DLL_EXPORT int thread_pool_size(const ThreadPool *pool)
+{
+    return pool ? pool->size : 0;
+}
+
+DLL_EXPORT int run_thread_pool(ThreadPool *pool, int task_count, PoolTask task, void *context)
+{
+    if (!pool || !task || task_count < 0)
+    {
+        fprintf(stderr, "Invalid input.\n");
+        return FAILURE;
+    }
+
+    pthread_mutex_lock(&pool->submit_lock);
+
+    // deal out contiguous ranges; no worker is running yet, so the range locks are not needed
+    for (int w = 0; w < pool->size; w++)
+    {
+        pool->ranges[w].next = (int)((long long)task_count * w / pool->size);
+        pool->ranges[w].end = (int)((long long)task_count * (w + 1) / pool->size);
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->task = task;
+    pool->context = context;
+    pool->busy_workers = pool->size - 1;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->work_ready);
+    pthread_mutex_unlock(&pool->lock);
+
+    drain_tasks(pool, 0);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->busy_workers > 0)
+    {
+        pthread_cond_wait(&pool->work_done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    pthread_mutex_unlock(&pool->submit_lock);
+    return SUCCESS;
+}
+
+DLL_EXPORT void cleanup_thread_pool(ThreadPool *pool)
+{
+    if (!pool)
+        return;
+    destroy_thread_pool(pool, pool->size, pool->size);
+}
+
+typedef struct
+{
+    const PricePanel *panel;
+    const IndicatorSpec *specs;
+    double **outs;
+    int chunks;            // symbol chunks per indicator
+    double *scratch;       // one block of `scratch_length` doubles per worker (column-major only)
+    size_t scratch_length;
+    atomic_int failed;
+} PanelJob;
+
+static void panel_task(void *context, int task, int worker)
+{
+    PanelJob *job = context;
+    int spec = task / job->chunks;
+    int first_symbol = (task % job->chunks) * PANEL_TASK_SYMBOLS;
+    int last_symbol = first_symbol + PANEL_TASK_SYMBOLS;
+    if (last_symbol > job->panel->symbols)
+        last_symbol = job->panel->symbols;
+
+    double *scratch = job->scratch ? job->scratch + worker * job->scratch_length : NULL;
+    if (compute_panel_range(job->panel, &job->specs[spec], job->outs[spec], first_symbol, last_symbol, scratch) != SUCCESS)
+        atomic_store(&job->failed, 1);
+}
+
+DLL_EXPORT int compute_panel_parallel(ThreadPool *pool, const PricePanel *panel, const IndicatorSpec *specs,
+                                      int spec_count, double **outs)
+{
+    if (!pool || !panel || !specs || !outs || spec_count <= 0 || panel->symbols <= 0)
+    {
+        fprintf(stderr, "Invalid input.\n");
+        return FAILURE;
+    }
+    for (int k = 0; k < spec_count; k++)
+    {
+        if (!outs[k] || indicator_lead(&specs[k]) < 0)
+        {
+            fprintf(stderr, "Invalid input.\n");
+            return FAILURE;
+        }
+    }
+
+    PanelJob job = {panel, specs, outs, (panel->symbols + PANEL_TASK_SYMBOLS - 1) / PANEL_TASK_SYMBOLS, NULL, 0, 0};
+    if (panel->layout == PANEL_COLUMN_MAJOR)
+    {
+        job.scratch_length = panel_scratch_length(panel, INDICATOR_MACD); // sized for the widest indicator
+        job.scratch = malloc(sizeof(double) * job.scratch_length * pool->size);
+        if (!job.scratch)
+        {
+            fprintf(stderr, "Malloc failed. %s.\n", strerror(errno));
+            return FAILURE;
+        }
+    }
+
+    int status = run_thread_pool(pool, job.chunks * spec_count, panel_task, &job);
+    free(job.scratch);
+    return (status == SUCCESS && !atomic_load(&job.failed)) ? SUCCESS : FAILURE;
+}
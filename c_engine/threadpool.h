@@ -0,0 +1,88 @@
+/**
+ * threadpool.h
+ * ------------
+ * Declarations for the built-in worker pool used to spread batch indicator jobs
+ * across CPU cores.
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include "indicators.h"
+#include "panel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct ThreadPool ThreadPool;
+
+/**
+ * @brief A unit of work run by the pool.
+ *
+ * @param context The pointer passed to run_thread_pool().
+ * @param task    Index of the task, in [0, task_count).
+ * @param worker  Index of the worker running it, in [0, thread_pool_size(pool)). No two
+ *                tasks run concurrently with the same worker index, so it can select
+ *                per-worker scratch memory.
+ */
+typedef void (*PoolTask)(void *context, int task, int worker);
+
+/**
+ * @brief Creates a worker pool.
+ *
+ * The thread calling run_thread_pool() works alongside the pool, so `threads - 1`
+ * background threads are started.
+ *
+ * @param threads Total number of workers; 0 or less uses the number of online CPUs.
+ *
+ * @return Pointer to the pool, or NULL if memory allocation or thread creation fails.
+ *
+ * @note Release the pool with cleanup_thread_pool().
+ */
+DLL_EXPORT ThreadPool *init_thread_pool(int threads);
+
+/**
+ * @brief Number of workers in the pool, including the calling thread.
+ */
+DLL_EXPORT int thread_pool_size(const ThreadPool *pool);
+
+/**
+ * @brief Runs tasks 0 .. task_count - 1 on the pool and waits for all of them.
+ *
+ * Tasks are dealt out to the workers in contiguous ranges; a worker that finishes its
+ * range steals half of the remaining tasks from another worker. Calls from several
+ * threads are serialized.
+ *
+ * @return SUCCESS, or FAILURE on invalid input.
+ */
+DLL_EXPORT int run_thread_pool(ThreadPool *pool, int task_count, PoolTask task, void *context);
+
+/**
+ * @brief Stops the workers and frees the pool. NULL is ignored.
+ */
+DLL_EXPORT void cleanup_thread_pool(ThreadPool *pool);
+
+/**
+ * @brief Computes several indicators for every symbol of a panel on the pool.
+ *
+ * Symbols are split into chunks and each (indicator, chunk) pair is a task. Every symbol
+ * is computed by the same code as compute_panel, so the results are identical to the
+ * serial functions regardless of the number of threads.
+ *
+ * @param pool       The worker pool.
+ * @param panel      The input matrix.
+ * @param specs      Array of `spec_count` indicators to compute.
+ * @param spec_count Number of indicators.
+ * @param outs       Array of `spec_count` output buffers, each sized as for compute_panel.
+ *
+ * @return SUCCESS, or FAILURE on invalid input or memory allocation failure.
+ */
+DLL_EXPORT int compute_panel_parallel(ThreadPool *pool, const PricePanel *panel, const IndicatorSpec *specs,
+                                      int spec_count, double **outs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // THREADPOOL_H
@@ -0,0 +1,450 @@
+/**
+ * bench_indicators.c
+ * ------------------
+ * Throughput benchmark for the c_engine compute functions. Build and run it with
+ * `make bench` in c_engine.
+ *
+ * Every function is timed over series of 10^3 .. 10^max points and, where it takes one,
+ * each window in BENCH_WINDOWS. For each case the report gives nanoseconds per input
+ * point (best and median sample), the memory traffic of the inputs and outputs in GB/s,
+ * and the heap allocations of one call. Results are written as JSON so runs can be
+ * compared across releases with tests/compare_bench.py.
+ *
+ * The engine objects are linked into this program with -Wl,--wrap=malloc,... so the
+ * allocation counters below see every allocation the engine makes.
+ *
+ * Usage: bench_indicators [--max-length N] [--min-time SECONDS] [--filter NAME] [--output FILE]
+ *                         [--scalar-rolling]
+ *
+ * --scalar-rolling disables the vectorized SMA / Bollinger kernels (set_rolling_simd(0)).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include "indicators.h"
+#include "panel.h"
+
+#define BENCH_SCHEMA_VERSION 1
+#define BENCH_SAMPLES 5
+#define BENCH_DEFAULT_MAX_LENGTH 10000000 // 10^8 needs several GB; pass --max-length 100000000
+#define BENCH_DEFAULT_MIN_TIME 0.2        // seconds per case, split across the samples
+#ifndef BENCH_PROFILE
+#define BENCH_PROFILE "default" // the Makefile build profile, set with -DBENCH_PROFILE
+#endif
+
+static const int BENCH_WINDOWS[] = {5, 20, 50, 200, 500};
+#define BENCH_WINDOW_COUNT ((int)(sizeof(BENCH_WINDOWS) / sizeof(BENCH_WINDOWS[0])))
+
+/*
+ * Allocation counting
+ * -------------------
+ * The linker routes the engine's malloc/calloc/realloc calls here. Counting is switched
+ * on only around one call of the function being measured.
+ */
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+static int counting;
+static long allocations;
+static size_t allocated_bytes;
+
+static void count_allocation(size_t bytes)
+{
+    if (counting)
+    {
+        allocations++;
+        allocated_bytes += bytes;
+    }
+}
+
+void *__wrap_malloc(size_t size)
+{
+    count_allocation(size);
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size)
+{
+    count_allocation(count * size);
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    count_allocation(size);
+    return __real_realloc(ptr, size);
+}
+
+/*
+ * Cases
+ * -----
+ */
+
+typedef struct
+{
+    double *prices;
+    double *volumes;
+    double *out; // room for `planes` outputs of `length` values, for the _into functions
+    int length;
+    int window;
+} BenchInput;
+
+typedef struct
+{
+    const char *name;
+    int windowed; // 0: the function takes no window and is run once per length
+    int inputs;   // series read: 1 (prices) or 2 (prices and volumes)
+    int planes;   // output arrays written
+    int (*run)(const BenchInput *in);
+} BenchCase;
+
+static int output_length(const BenchCase *c, int length, int window)
+{
+    if (strstr(c->name, "MACD"))
+        return compute_output_length(INDICATOR_MACD, length, 0);
+    if (strstr(c->name, "indicator_set") || strstr(c->name, "OBV"))
+        return length;
+    if (strstr(c->name, "RSI"))
+        return compute_output_length(INDICATOR_RSI, length, window);
+    return compute_output_length(INDICATOR_SMA, length, window);
+}
+
+static int run_SMA(const BenchInput *in)
+{
+    double *result = compute_SMA(in->prices, in->length, in->window);
+    c_free(result);
+    return result == NULL;
+}
+
+static int run_SMA_into(const BenchInput *in)
+{
+    return compute_SMA_into(in->prices, in->length, in->window, in->out);
+}
+
+static int run_EMA(const BenchInput *in)
+{
+    double *result = compute_EMA(in->prices, in->length, in->window);
+    c_free(result);
+    return result == NULL;
+}
+
+static int run_EMA_into(const BenchInput *in)
+{
+    return compute_EMA_into(in->prices, in->length, in->window, in->out);
+}
+
+static int run_RSI(const BenchInput *in)
+{
+    double *result = compute_RSI(in->prices, in->length, in->window);
+    c_free(result);
+    return result == NULL;
+}
+
+static int run_RSI_into(const BenchInput *in)
+{
+    return compute_RSI_into(in->prices, in->length, in->window, in->out);
+}
+
+static int run_rolling_mean_std(const BenchInput *in)
+{
+    return compute_rolling_mean_std(in->prices, in->length, in->window, in->out, in->out + in->length);
+}
+
+static int run_bollinger_bands(const BenchInput *in)
+{
+    BollingerBands *bands = compute_bollinger_bands(in->prices, in->length, in->window, 2.0);
+    cleanup_bands(bands);
+    return bands == NULL;
+}
+
+static int run_bollinger_bands_into(const BenchInput *in)
+{
+    return compute_bollinger_bands_into(in->prices, in->length, in->window, 2.0, in->out, in->out + in->length,
+                                        in->out + 2 * (size_t)in->length);
+}
+
+static int run_MACD(const BenchInput *in)
+{
+    MACD *macd = compute_MACD(in->prices, in->length);
+    if (!macd)
+        return 1;
+    cleanup_MACD(macd);
+    return 0;
+}
+
+static int run_MACD_periods_into(const BenchInput *in)
+{
+    return compute_MACD_periods_into(in->prices, in->length, MACD_FAST_PERIOD, MACD_SLOW_PERIOD, MACD_SIGNAL_PERIOD,
+                                     in->out, in->out + in->length, in->out + 2 * (size_t)in->length);
+}
+
+static int run_OBV(const BenchInput *in)
+{
+    double *result = compute_OBV(in->prices, in->volumes, in->length);
+    c_free(result);
+    return result == NULL;
+}
+
+static int run_OBV_into(const BenchInput *in)
+{
+    return compute_OBV_into(in->prices, in->volumes, in->length, in->out);
+}
+
+static int run_RSI_OBV_into(const BenchInput *in)
+{
+    return compute_RSI_OBV_into(in->prices, in->volumes, in->length, in->window, in->out, in->out + in->length);
+}
+
+// a typical dashboard: SMA, EMA, RSI and Bollinger Bands at the window, plus MACD and OBV
+static int run_indicator_set(const BenchInput *in)
+{
+    IndicatorSpec specs[6] = {
+        {.type = INDICATOR_SMA, .window = in->window},
+        {.type = INDICATOR_EMA, .window = in->window},
+        {.type = INDICATOR_RSI, .window = in->window},
+        {.type = INDICATOR_BOLLINGER, .window = in->window, .std_devs = 2.0},
+        {.type = INDICATOR_MACD, .fast_period = MACD_FAST_PERIOD, .slow_period = MACD_SLOW_PERIOD,
+         .signal_period = MACD_SIGNAL_PERIOD},
+        {.type = INDICATOR_OBV},
+    };
+    size_t n = (size_t)in->length;
+    double *outs[6] = {in->out, in->out + n, in->out + 2 * n, in->out + 3 * n, in->out + 6 * n, in->out + 9 * n};
+    return compute_indicator_set(specs, 6, in->prices, in->volumes, in->length, outs);
+}
+
+static const BenchCase CASES[] = {
+    {"compute_SMA", 1, 1, 1, run_SMA},
+    {"compute_SMA_into", 1, 1, 1, run_SMA_into},
+    {"compute_EMA", 1, 1, 1, run_EMA},
+    {"compute_EMA_into", 1, 1, 1, run_EMA_into},
+    {"compute_RSI", 1, 1, 1, run_RSI},
+    {"compute_RSI_into", 1, 1, 1, run_RSI_into},
+    {"compute_rolling_mean_std", 1, 1, 2, run_rolling_mean_std},
+    {"compute_bollinger_bands", 1, 1, 3, run_bollinger_bands},
+    {"compute_bollinger_bands_into", 1, 1, 3, run_bollinger_bands_into},
+    {"compute_MACD", 0, 1, 3, run_MACD},
+    {"compute_MACD_periods_into", 0, 1, 3, run_MACD_periods_into},
+    {"compute_OBV", 0, 2, 1, run_OBV},
+    {"compute_OBV_into", 0, 2, 1, run_OBV_into},
+    {"compute_RSI_OBV_into", 1, 2, 2, run_RSI_OBV_into},
+    {"compute_indicator_set", 1, 2, 10, run_indicator_set},
+};
+#define CASE_COUNT ((int)(sizeof(CASES) / sizeof(CASES[0])))
+
+/*
+ * Timing
+ * ------
+ */
+
+static double now_seconds(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+}
+
+static int compare_doubles(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+typedef struct
+{
+    long iterations; // calls per sample
+    double best;     // seconds per call
+    double median;
+    long allocations;
+    size_t allocated_bytes;
+} BenchTiming;
+
+static int time_case(const BenchCase *c, const BenchInput *in, double min_time, BenchTiming *timing)
+{
+    // one counted call, which also warms the caches and faults in the output buffer
+    allocations = 0;
+    allocated_bytes = 0;
+    counting = 1;
+    int failed = c->run(in);
+    counting = 0;
+    if (failed)
+        return FAILURE;
+    timing->allocations = allocations;
+    timing->allocated_bytes = allocated_bytes;
+
+    // enough calls per sample that each sample lasts about min_time / BENCH_SAMPLES
+    double target = min_time / BENCH_SAMPLES;
+    long iterations = 1;
+    for (;;)
+    {
+        double start = now_seconds();
+        for (long i = 0; i < iterations; i++)
+            c->run(in);
+        double elapsed = now_seconds() - start;
+        if (elapsed >= target || iterations >= (1L << 30))
+            break;
+        long scaled = (elapsed > 0) ? (long)(iterations * 1.2 * target / elapsed) : iterations * 16;
+        iterations = (scaled > iterations) ? scaled : iterations * 2;
+    }
+
+    double samples[BENCH_SAMPLES];
+    for (int s = 0; s < BENCH_SAMPLES; s++)
+    {
+        double start = now_seconds();
+        for (long i = 0; i < iterations; i++)
+            c->run(in);
+        samples[s] = (now_seconds() - start) / (double)iterations;
+    }
+    qsort(samples, BENCH_SAMPLES, sizeof(double), compare_doubles);
+    timing->iterations = iterations;
+    timing->best = samples[0];
+    timing->median = samples[BENCH_SAMPLES / 2];
+    return SUCCESS;
+}
+
+/*
+ * Driver
+ * ------
+ */
+
+static const char *simd_level_name(int level)
+{
+    switch (level)
+    {
+    case SIMD_AVX2:
+        return "avx2";
+    case SIMD_AVX512:
+        return "avx512";
+    default:
+        return "scalar";
+    }
+}
+
+static void fill_series(double *prices, double *volumes, int length)
+{
+    // a random walk, so the RSI and OBV branches are unpredictable as on real data
+    unsigned long long state = 0x9E3779B97F4A7C15ULL;
+    double price = 100.0;
+    for (int i = 0; i < length; i++)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        double step = (double)(state >> 11) / 9007199254740992.0 - 0.5; // uniform in [-0.5, 0.5)
+        price += step;
+        prices[i] = price;
+        volumes[i] = 1e6 + (double)(state >> 44);
+    }
+}
+
+static void usage(const char *program)
+{
+    fprintf(stderr, "Usage: %s [--max-length N] [--min-time SECONDS] [--filter NAME] [--output FILE] [--scalar-rolling]\n",
+            program);
+}
+
+int main(int argc, char **argv)
+{
+    long max_length = BENCH_DEFAULT_MAX_LENGTH;
+    double min_time = BENCH_DEFAULT_MIN_TIME;
+    const char *filter = NULL;
+    const char *output = NULL;
+    for (int i = 1; i < argc; i++)
+    {
+        if (i + 1 < argc && strcmp(argv[i], "--max-length") == 0)
+            max_length = (long)strtod(argv[++i], NULL);
+        else if (i + 1 < argc && strcmp(argv[i], "--min-time") == 0)
+            min_time = strtod(argv[++i], NULL);
+        else if (i + 1 < argc && strcmp(argv[i], "--filter") == 0)
+            filter = argv[++i];
+        else if (i + 1 < argc && strcmp(argv[i], "--output") == 0)
+            output = argv[++i];
+        else if (strcmp(argv[i], "--scalar-rolling") == 0)
+            set_rolling_simd(0);
+        else
+        {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (max_length < 1000 || max_length > 1000000000L || min_time <= 0)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    FILE *json = output ? fopen(output, "w") : stdout;
+    double *prices = malloc(sizeof(double) * (size_t)max_length);
+    double *volumes = malloc(sizeof(double) * (size_t)max_length);
+    if (!json || !prices || !volumes)
+    {
+        fprintf(stderr, "Setup failed.\n");
+        return 1;
+    }
+    fill_series(prices, volumes, (int)max_length);
+
+    fprintf(json, "{\n  \"schema\": %d,\n  \"compiler\": \"%s\",\n  \"build_profile\": \"%s\",\n  \"simd_level\": \"%s\",\n"
+            "  \"rolling_simd\": %s,\n  \"results\": [",
+            BENCH_SCHEMA_VERSION, __VERSION__, BENCH_PROFILE, simd_level_name(get_simd_level()),
+            get_rolling_simd() ? "true" : "false");
+    int first_result = 1;
+    for (long length = 1000; length <= max_length; length *= 10)
+    {
+        for (int c = 0; c < CASE_COUNT; c++)
+        {
+            const BenchCase *bench = &CASES[c];
+            if (filter && !strstr(bench->name, filter))
+                continue;
+
+            // the _into functions write to this; the allocating ones only need it to exist
+            double *out = malloc(sizeof(double) * (size_t)bench->planes * (size_t)length);
+            if (!out)
+            {
+                fprintf(stderr, "%s: skipped length %ld, not enough memory\n", bench->name, length);
+                continue;
+            }
+
+            int windows = bench->windowed ? BENCH_WINDOW_COUNT : 1;
+            for (int w = 0; w < windows; w++)
+            {
+                int window = bench->windowed ? BENCH_WINDOWS[w] : 0;
+                int outputs = output_length(bench, (int)length, window);
+                if (outputs <= 0)
+                    continue;
+
+                BenchInput in = {prices, volumes, out, (int)length, window};
+                BenchTiming timing;
+                if (time_case(bench, &in, min_time, &timing) != SUCCESS)
+                {
+                    fprintf(stderr, "%s: failed at length %ld window %d\n", bench->name, length, window);
+                    continue;
+                }
+
+                double bytes = 8.0 * ((double)bench->inputs * (double)length + (double)bench->planes * outputs);
+                double ns_per_point = timing.best * 1e9 / (double)length;
+                double gb_per_s = bytes / timing.best * 1e-9;
+                fprintf(json,
+                        "%s\n    {\"function\": \"%s\", \"length\": %ld, \"window\": %d, \"iterations\": %ld, "
+                        "\"ns_per_point\": %.4f, \"ns_per_point_median\": %.4f, \"gb_per_s\": %.3f, "
+                        "\"bytes_per_call\": %.0f, \"allocations\": %ld, \"allocated_bytes\": %zu}",
+                        first_result ? "" : ",", bench->name, length, window, timing.iterations, ns_per_point,
+                        timing.median * 1e9 / (double)length, gb_per_s, bytes, timing.allocations,
+                        timing.allocated_bytes);
+                first_result = 0;
+                fprintf(stderr, "%-30s length %10ld window %3d  %9.3f ns/point %8.2f GB/s  %ld allocs\n",
+                        bench->name, length, window, ns_per_point, gb_per_s, timing.allocations);
+            }
+            free(out);
+        }
+    }
+    fprintf(json, "\n  ]\n}\n");
+
+    if (output)
+        fclose(json);
+    free(prices);
+    free(volumes);
+    return 0;
+}
@@ -0,0 +1,77 @@
+#!/usr/bin/env python3
+# Performance regression gate for the c_engine benchmark (tests/bench_indicators.c).
+#
+# Compares a new bench JSON file against a baseline case by case (function, length, window) and
+# prints a per-function report. Exits with status 1 when any case is slower than the baseline by more
+# than the threshold, or makes more heap allocations per call. Run it through make:
+#
+#   make -C c_engine bench-baseline            # on the reference build
+#   make -C c_engine bench-check               # after a change; fails on a regression
+#
+# or directly: python3 tests/compare_bench.py BASELINE.json NEW.json [--threshold 0.10]
+import argparse
+import json
+import sys
+
+def load_results(path):
+    with open(path) as f:
+        report = json.load(f)
+    cases = {(r["function"], r["length"], r["window"]): r for r in report["results"]}
+    return report, cases
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare two bench_indicators JSON files.")
+    parser.add_argument("baseline")
+    parser.add_argument("new")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="largest allowed slowdown as a fraction (default 0.10 = 10%%)")
+    parser.add_argument("--metric", default="ns_per_point", choices=["ns_per_point", "ns_per_point_median"],
+                        help="timing compared (default: best sample)")
+    parser.add_argument("--min-length", type=int, default=10000,
+                        help="ignore shorter series, whose timings are dominated by noise (default 10000)")
+    parser.add_argument("--ignore-allocations", action="store_true",
+                        help="do not fail when a case allocates more than in the baseline")
+    args = parser.parse_args()
+
+    baseline_report, baseline = load_results(args.baseline)
+    new_report, new = load_results(args.new)
+    for field in ("compiler", "build_profile", "simd_level", "rolling_simd"):
+        if baseline_report.get(field) != new_report.get(field):
+            print(f"warning: {field} differs: {baseline_report.get(field)} (baseline) vs {new_report.get(field)}")
+
+    by_function = {}
+    for key in sorted(baseline.keys() & new.keys()):
+        if key[1] < args.min_length:
+            continue
+        old_case, new_case = baseline[key], new[key]
+        ratio = new_case[args.metric] / old_case[args.metric] if old_case[args.metric] > 0 else 1.0
+        problems = []
+        if ratio > 1.0 + args.threshold:
+            problems.append(f"{(ratio - 1.0) * 100:+.1f}% time")
+        if not args.ignore_allocations and new_case["allocations"] > old_case["allocations"]:
+            problems.append(f"allocations {old_case['allocations']} -> {new_case['allocations']}")
+        by_function.setdefault(key[0], []).append((key, ratio, problems))
+
+    failed = False
+    print(f"{'function':<30} {'cases':>5} {'best':>8} {'worst':>8}  status")
+    for function, cases in by_function.items():
+        ratios = [ratio for _, ratio, _ in cases]
+        regressions = [(key, problems) for key, _, problems in cases if problems]
+        status = "REGRESSED" if regressions else "ok"
+        print(f"{function:<30} {len(cases):>5} {(min(ratios) - 1) * 100:+7.1f}% {(max(ratios) - 1) * 100:+7.1f}%  {status}")
+        for (_, length, window), problems in regressions:
+            print(f"    length {length:>10} window {window:>3}: {', '.join(problems)}")
+        failed = failed or bool(regressions)
+
+    missing = sorted(baseline.keys() - new.keys())
+    if missing:
+        print(f"warning: {len(missing)} baseline cases missing from {args.new}, e.g. {missing[0]}")
+    if not by_function:
+        print("error: no cases in common")
+        return 1
+
+    print(f"{'FAIL' if failed else 'PASS'}: threshold {args.threshold * 100:.0f}% on {args.metric}")
+    return 1 if failed else 0
+
+if __name__ == "__main__":
+    sys.exit(main())
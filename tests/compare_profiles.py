@@ -0,0 +1,61 @@
+#!/usr/bin/env python3
+# Speedup of the c_engine build profiles (release, native, lto, pgo; see c_engine/Makefile).
+#
+# Takes the bench JSON of a reference build followed by one per profile and prints, for each function,
+# the geometric mean speedup of every profile over the reference across the cases they share (best
+# sample ns/point, series of at least --min-length points). Run it through make, which benchmarks
+# the default build and every profile first:
+#
+#   make -C c_engine bench-profiles BENCH_ARGS="--max-length 1000000"
+#
+# or directly: python3 tests/compare_profiles.py REFERENCE.json PROFILE.json [PROFILE.json ...]
+import argparse
+import math
+import sys
+from compare_bench import load_results
+
+def geometric_mean(values):
+    return math.exp(sum(math.log(v) for v in values) / len(values)) if values else float("nan")
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare bench_indicators JSON files of several build profiles.")
+    parser.add_argument("reference")
+    parser.add_argument("profiles", nargs="+")
+    parser.add_argument("--metric", default="ns_per_point", choices=["ns_per_point", "ns_per_point_median"],
+                        help="timing compared (default: best sample)")
+    parser.add_argument("--min-length", type=int, default=10000,
+                        help="ignore shorter series, whose timings are dominated by noise (default 10000)")
+    args = parser.parse_args()
+
+    reference_report, reference = load_results(args.reference)
+    runs = []
+    for path in args.profiles:
+        report, cases = load_results(path)
+        if report.get("simd_level") != reference_report.get("simd_level"):
+            print(f"warning: {path} ran with SIMD level {report.get('simd_level')}, "
+                  f"the reference with {reference_report.get('simd_level')}")
+        runs.append((report.get("build_profile", path), cases))
+
+    functions = sorted({key[0] for key in reference})
+    speedups = {} # (function, profile) -> per-case speedups
+    for name, cases in runs:
+        for key in reference.keys() & cases.keys():
+            old, new = reference[key][args.metric], cases[key][args.metric]
+            if key[1] >= args.min_length and old > 0 and new > 0:
+                speedups.setdefault((key[0], name), []).append(old / new)
+    if not speedups:
+        print("error: no cases in common")
+        return 1
+
+    names = [name for name, _ in runs]
+    print(f"speedup over {reference_report.get('build_profile', args.reference)} ({args.metric}, geometric mean)")
+    print(f"{'function':<30}" + "".join(f" {name:>9}" for name in names))
+    for function in functions:
+        cells = [geometric_mean(speedups.get((function, name), [])) for name in names]
+        print(f"{function:<30}" + "".join(f" {cell:>8.2f}x" for cell in cells))
+    overall = [geometric_mean([s for (_, n), values in speedups.items() if n == name for s in values]) for name in names]
+    print(f"{'all functions':<30}" + "".join(f" {cell:>8.2f}x" for cell in overall))
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -1,7 +1,14 @@
 #!/bin/bash
 
-# Compile test program
-gcc -Wall -Werror -o test_indicators test_indicators.c indicators.c -lm
+# BENCH_BASELINE=path/to/bench.json also runs the benchmark and fails on a performance regression
+BASELINE=${BENCH_BASELINE:+$(realpath "$BENCH_BASELINE")}
+cd "$(dirname "$0")"
+ENGINE_DIR=../c_engine
+
+# Build the shared library, then compile the test program against it
+make -s -C "$ENGINE_DIR" || { echo "Library build failed"; exit 1; }
+gcc -Wall -Werror -I"$ENGINE_DIR" -o test_indicators test_indicators.c \
+    -L"$ENGINE_DIR" -l:indicators.so -Wl,-rpath,"$(cd "$ENGINE_DIR" && pwd)" -lm
 
 if [ $? -ne 0 ]; then
     echo "Compilation failed"
@@ -27,3 +34,25 @@ else
     echo "SMA test failed"
     exit 1
 fi
+
+# The same tests under AddressSanitizer, LeakSanitizer and UBSan, built straight from the engine
+# sources: an out-of-bounds write, a block left allocated (e.g. a MACD not released whole by
+# cleanup_MACD) or undefined behaviour fails the run. Skipped when the compiler lacks the runtimes
+if echo 'int main(void) { return 0; }' | gcc -fsanitize=address,undefined -x c -o /dev/null - 2>/dev/null; then
+    gcc -g -O1 -fsanitize=address,undefined -fno-sanitize-recover=all -pthread -ffp-contract=off -I"$ENGINE_DIR" \
+        -o test_indicators_sanitized test_indicators.c "$ENGINE_DIR"/*.c -lm || { echo "Sanitizer build failed"; exit 1; }
+    sanitizer_log=$(./test_indicators_sanitized 2>&1 >/dev/null) ||
+        { echo "$sanitizer_log" | tail -40; echo "Sanitizer run failed"; exit 1; }
+    echo "Sanitizer run passed"
+fi
+
+# The static library from C++: the headers must be C++-safe and link without indicators.so
+make -s -C "$ENGINE_DIR" static || { echo "Static library build failed"; exit 1; }
+g++ -std=c++17 -Wall -Werror -I"$ENGINE_DIR" -o test_embed test_embed.cpp \
+    "$ENGINE_DIR/libindicators.a" -lm -lpthread || { echo "C++ static link failed"; exit 1; }
+./test_embed || { echo "Static embedding test failed"; exit 1; }
+
+if [ -n "$BASELINE" ]; then
+    make -s -C "$ENGINE_DIR" bench-check BENCH_BASELINE="$BASELINE" BENCH_ARGS="$BENCH_ARGS" 2>/dev/null ||
+        { echo "Performance regression against $BASELINE"; exit 1; }
+fi
@@ -0,0 +1,93 @@
+import os
+import sys
+import tempfile
+import numpy as np
+
+# backend modules import each other by module name, as when the app runs from backend/
+sys.path.append(os.path.abspath(os.path.join(os.path.dirname(__file__), '..', 'backend')))
+
+# the app needs an API key and loads its price store at import: point it at a small generated series
+DATA_DIR = tempfile.mkdtemp()
+PRICES = 100.0 + 10.0 * np.sin(np.arange(120) * 0.1)
+VOLUMES = 1000.0 + np.arange(120) % 5
+with open(os.path.join(DATA_DIR, "TEST.csv"), "w") as f:
+    f.write("timestamp,open,high,low,close,volume\n")
+    for day, (price, volume) in enumerate(zip(PRICES, VOLUMES)):
+        date = np.datetime64("2024-01-01") + np.timedelta64(day, "D")
+        price, volume = float(price), float(volume) # repr() of a Python float round-trips exactly
+        f.write(f"{date},{price!r},{price!r},{price!r},{price!r},{volume!r}\n")
+os.environ.setdefault("ALPHA_VANTAGE_API_KEY", "test")
+os.environ["PRICE_DATA_DIR"] = DATA_DIR
+
+from fastapi.testclient import TestClient
+from app import app
+from binary_format import decode_arrays
+
+client = TestClient(app)
+
+def test_invalid_parameters_are_422():
+    prices = PRICES[:30].tolist()
+    requests = [
+        ("/get_sma", {"prices": prices, "window": 0}),
+        ("/get_ema", {"prices": prices, "window": 31}),
+        ("/get_rsi", {"prices": prices, "window": 30}),
+        ("/get_bollinger_bands", {"prices": prices, "window": -1}),
+        ("/get_macd", {"prices": prices}), # too short for the default periods
+        ("/get_obv", {"prices": prices, "volumes": prices[:10]}),
+        ("/get_indicators", {"prices": prices, "indicators": [{"indicator": "sma", "window": 0}]}),
+        ("/get_indicators", {"prices": prices, "indicators": [{"indicator": "vwap"}]}),
+        ("/symbols/TEST/indicators", {"indicators": [{"indicator": "rsi", "window": 500}]}),
+    ]
+    for path, body in requests:
+        response = client.post(path, json=body)
+        assert response.status_code == 422, (path, body, response.status_code)
+        assert response.json()["detail"], path
+
+    assert client.get("/symbols/TEST/sma", params={"window": 0}).status_code == 422
+    assert client.post("/symbols/TEST/bars", json={"timestamps": ["2023-01-01"], "open": [1.0], "high": [1.0],
+                                                   "low": [1.0], "close": [1.0], "volume": [1.0]}).status_code == 422
+
+def test_unknown_symbol_is_404():
+    assert client.get("/symbols/NOPE/sma", params={"window": 5}).status_code == 404
+
+def test_valid_requests_still_succeed():
+    response = client.post("/get_sma", json={"prices": PRICES[:30].tolist(), "window": 5})
+    assert response.status_code == 200 and len(response.json()) == 26
+
+def test_binary_responses_match_json():
+    prices = PRICES.tolist()
+    requests = [
+        ("/get_sma", {"prices": prices, "window": 20}),
+        ("/get_bollinger_bands", {"prices": prices, "window": 20, "std_devs": 2.0}),
+        ("/get_macd", {"prices": prices}),
+        ("/get_obv", {"prices": prices, "volumes": VOLUMES.tolist()}),
+        ("/get_indicators", {"prices": prices, "volumes": VOLUMES.tolist(),
+                             "indicators": [{"indicator": "rsi", "window": 14}, {"indicator": "macd"},
+                                            {"indicator": "bollinger_bands", "window": 10}]}),
+        ("/symbols/TEST/indicators", {"indicators": [{"indicator": "ema", "window": 10}, {"indicator": "obv"}]}),
+    ]
+    for path, body in requests:
+        expected = client.post(path, json=body).json()
+        if path.startswith("/get_") and path != "/get_indicators":
+            expected = [expected]
+        response = client.post(path, json=body, headers={"Accept": "application/vnd.indicators.f64"})
+        assert response.status_code == 200 and response.headers["content-type"] == "application/vnd.indicators.f64"
+        decoded = decode_arrays(response.content)
+        assert len(decoded) == len(expected), path
+        for values, json_values in zip(decoded, expected):
+            # JSON floats round-trip float64 exactly, so the binary frames must hold the same bits
+            assert np.array_equal(values, np.array(json_values)), path
+
+        response = client.post(path, json=body, headers={"Accept": "application/vnd.indicators.f32"})
+        for values, json_values in zip(decode_arrays(response.content), expected):
+            assert np.array_equal(values, np.array(json_values, dtype=np.float32)), path
+
+    response = client.get("/symbols/TEST/rsi", params={"window": 14}, headers={"Accept": "application/octet-stream"})
+    (values,) = decode_arrays(response.content)
+    assert np.array_equal(values, np.array(client.get("/symbols/TEST/rsi", params={"window": 14}).json()))
+
+if __name__ == "__main__":
+    for test in (test_invalid_parameters_are_422, test_unknown_symbol_is_404, test_valid_requests_still_succeed,
+                 test_binary_responses_match_json):
+        test()
+        print(f"✅ {test.__name__} passed")
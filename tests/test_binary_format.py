@@ -0,0 +1,52 @@
+import os
+import sys
+import numpy as np
+
+# backend modules import each other by module name, as when the app runs from backend/
+sys.path.append(os.path.abspath(os.path.join(os.path.dirname(__file__), '..', 'backend')))
+
+from binary_format import HEADER, MEDIA_TYPES, binary_media_type, decode_arrays, encode_array, encode_arrays
+
+def test_accept_negotiation():
+    assert binary_media_type(None) is None
+    assert binary_media_type("application/json") is None
+    assert binary_media_type("application/json, application/vnd.indicators.f32;q=0.9") == "application/vnd.indicators.f32"
+    assert binary_media_type("Application/Octet-Stream") == "application/octet-stream"
+
+def test_round_trip_is_exact_for_float64():
+    vector = np.array([1.5, -0.0, np.inf, 1e-300, np.nan, 123456.789])
+    table = np.arange(12, dtype=np.double).reshape(4, 3) / 7.0
+    arrays = [vector, vector[:0], table, table.T]
+    decoded = decode_arrays(encode_arrays(arrays, MEDIA_TYPES["application/vnd.indicators.f64"]))
+    assert len(decoded) == len(arrays)
+    for expected, actual in zip(arrays, decoded):
+        assert actual.shape == expected.shape and actual.dtype == np.dtype("<f8")
+        assert np.array_equal(actual.view(np.uint64), np.ascontiguousarray(expected).view(np.uint64))
+
+def test_float32_frames():
+    values = np.linspace(-3.0, 3.0, 17)
+    frame = encode_array(values, MEDIA_TYPES["application/vnd.indicators.f32"])
+    assert len(frame) == HEADER.size + 4 * len(values)
+    (decoded,) = decode_arrays(frame)
+    assert decoded.dtype == np.dtype("<f4")
+    assert np.array_equal(decoded, values.astype(np.float32))
+
+def test_header_layout():
+    frame = encode_array(np.zeros((5, 3)), np.dtype("<f8"))
+    assert frame[:4] == b"IND1" and frame[4:5] == b"d" and frame[5] == 2 and frame[6:8] == b"\0\0"
+    assert int.from_bytes(frame[8:12], "little") == 5 and int.from_bytes(frame[12:16], "little") == 3
+
+def test_rejects_bad_input():
+    for call in (lambda: encode_array(np.zeros((2, 2, 2)), np.dtype("<f8")),
+                 lambda: decode_arrays(b"XXXX" + bytes(12))):
+        try:
+            call()
+        except ValueError:
+            continue
+        assert False, "expected ValueError"
+
+if __name__ == "__main__":
+    for test in (test_accept_negotiation, test_round_trip_is_exact_for_float64, test_float32_frames,
+                 test_header_layout, test_rejects_bad_input):
+        test()
+        print(f"✅ {test.__name__} passed")
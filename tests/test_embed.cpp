@@ -0,0 +1,55 @@
+// Links the engine statically (libindicators.a) into a C++ program, as an embedding service does:
+// the public headers must compile as C++ and the kernels must resolve without the shared library.
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <vector>
+#include "indicators.h"
+#include "panel.h"
+#include "threadpool.h"
+#include "price_file.h"
+#include "csv_parser.h"
+#include "series_hash.h"
+
+int main()
+{
+    const int length = 1000;
+    const int window = 20;
+    std::vector<double> prices(length);
+    for (int i = 0; i < length; i++)
+        prices[i] = 100.0 + 10.0 * std::sin(i * 0.05);
+
+    std::vector<double> sma(compute_output_length(INDICATOR_SMA, length, window));
+    if (compute_SMA_into(prices.data(), length, window, sma.data()) != SUCCESS)
+    {
+        std::printf("compute_SMA_into failed\n");
+        return 1;
+    }
+
+    // the streaming form fed bar by bar must reproduce the batch values, to within the rounding of
+    // the vectorized kernels (prices stay below 110)
+    const double tolerance = SIMD_RELATIVE_TOLERANCE * 110.0;
+    std::unique_ptr<SMAStream, void (*)(SMAStream *)> stream(init_SMA_stream(prices.data(), window, window),
+                                                             cleanup_SMA_stream);
+    if (!stream || std::fabs(get_SMA_stream_value(stream.get()) - sma[0]) > tolerance)
+    {
+        std::printf("init_SMA_stream failed\n");
+        return 1;
+    }
+    for (int i = window; i < length; i++)
+    {
+        if (std::fabs(update_SMA_stream(stream.get(), prices[i]) - sma[i - window + 1]) > tolerance)
+        {
+            std::printf("SMA stream differs at %d\n", i);
+            return 1;
+        }
+    }
+
+    if (hash_series(prices.data(), length, 0) != hash_series(prices.data(), length, 0))
+    {
+        std::printf("hash_series is not deterministic\n");
+        return 1;
+    }
+    std::printf("Static embedding test passed\n");
+    return 0;
+}
@@ -0,0 +1,119 @@
+import os
+import sys
+import numpy as np
+
+# backend modules import each other by module name, as when the app runs from backend/
+sys.path.append(os.path.abspath(os.path.join(os.path.dirname(__file__), '..', 'backend')))
+
+from incremental import IncrementalResults, stream_key
+from wrapper import compute_SMA, compute_EMA, compute_RSI, compute_OBV, compute_indicator_set
+from utils.load_prices import PriceSeries
+
+SIMD_RELATIVE_TOLERANCE = 1e-12 # c_engine/indicators.h
+
+def spec(indicator, window=0, fast_period=12, slow_period=26, signal_period=9):
+    # the parameters of an IndicatorRequest in app.py
+    return {"indicator": indicator, "window": window, "std_devs": 2.0,
+            "fast_period": fast_period, "slow_period": slow_period, "signal_period": signal_period}
+
+SPECS = [spec("sma", 5), spec("sma", 30), spec("ema", 12), spec("rsi", 14), spec("macd"),
+         spec("macd", fast_period=5, slow_period=35, signal_period=5), spec("obv")]
+
+def bars(first, count):
+    index = np.arange(first, first + count)
+    timestamps = np.datetime64("2024-01-01", "s") + index.astype("timedelta64[D]")
+    close = 100.0 + 10.0 * np.sin(index * 0.07) + (index % 5) * 0.3
+    return timestamps, {"close": close, "volume": 1000.0 + (index % 11) * 10.0}
+
+def make_series(count):
+    timestamps, columns = bars(0, count)
+    return PriceSeries("TEST", timestamps, columns)
+
+def full_recompute(series, indicator_spec, last):
+    # the batch function over bars [0, last)
+    close = series.columns["close"][:last]
+    indicator = indicator_spec["indicator"]
+    if indicator == "sma":
+        return compute_SMA(close, indicator_spec["window"])
+    if indicator == "ema":
+        return compute_EMA(close, indicator_spec["window"])
+    if indicator == "rsi":
+        return compute_RSI(close, indicator_spec["window"])
+    if indicator == "obv":
+        return compute_OBV(close, series.columns["volume"][:last])
+    return compute_indicator_set(close, [indicator_spec])[0]
+
+def assert_matches(result, expected, indicator):
+    assert result.shape == expected.shape, indicator
+    if indicator == "sma":
+        # the vectorized batch kernels round differently from the stream's running sum
+        assert np.allclose(result, expected, rtol=0.0, atol=SIMD_RELATIVE_TOLERANCE * np.max(np.abs(expected))), indicator
+    else:
+        assert np.array_equal(result, expected), indicator
+
+def test_stream_keys():
+    assert stream_key(spec("sma", 5)) != stream_key(spec("sma", 6))
+    assert stream_key(spec("obv", 5)) == stream_key(spec("obv", 6)) # OBV has no window
+    assert stream_key(spec("macd")) != stream_key(spec("macd", fast_period=5, slow_period=35, signal_period=5))
+    assert stream_key(spec("bollinger_bands", 20)) is None
+
+def test_append_matches_full_recompute():
+    results = IncrementalResults(64)
+    series = make_series(200)
+    for indicator_spec in SPECS:
+        assert_matches(results.results(series, indicator_spec, len(series)),
+                       full_recompute(series, indicator_spec, len(series)), indicator_spec["indicator"])
+
+    # several appends, including single bars; each only feeds the new bars to the streams
+    first = len(series)
+    for count in (1, 1, 17, 300):
+        previous = series
+        series = series.appended(*bars(first, count))
+        first += count
+        for indicator_spec in SPECS:
+            before = results.results(previous, indicator_spec, len(previous)).copy()
+            after = results.results(series, indicator_spec, len(series))
+            assert_matches(after, full_recompute(series, indicator_spec, len(series)), indicator_spec["indicator"])
+            assert np.array_equal(after[:len(before)], before) # earlier outputs are never rewritten
+
+def test_prefix_results():
+    results = IncrementalResults(64)
+    series = make_series(150).appended(*bars(150, 50))
+    for indicator_spec in SPECS:
+        for last in (60, 149, 200):
+            assert_matches(results.results(series, indicator_spec, last),
+                           full_recompute(series, indicator_spec, last), indicator_spec["indicator"])
+        result = results.results(series, indicator_spec, 60)
+        assert not result.flags.writeable
+
+def test_reload_rebuilds_the_stream():
+    results = IncrementalResults(64)
+    series = make_series(120)
+    results.results(series, spec("ema", 10), len(series))
+    timestamps, columns = bars(0, 120)
+    columns["close"] = columns["close"] * 2.0 # a reload with revised history: a new lineage
+    reloaded = PriceSeries("TEST", timestamps, columns)
+    assert np.array_equal(results.results(reloaded, spec("ema", 10), 120), compute_EMA(columns["close"], 10))
+
+def test_too_short_is_value_error():
+    results = IncrementalResults(64)
+    series = make_series(20)
+    for indicator_spec in (spec("rsi", 20), spec("macd"), spec("sma", 0)):
+        try:
+            results.results(series, indicator_spec, len(series))
+            assert False, "expected ValueError"
+        except ValueError:
+            pass
+
+def test_tracker_limit():
+    results = IncrementalResults(2)
+    series = make_series(100)
+    for window in (3, 4, 5, 3):
+        assert_matches(results.results(series, spec("sma", window), 100), compute_SMA(series.columns["close"], window), "sma")
+    assert len(results._trackers) == 2
+
+if __name__ == "__main__":
+    for test in (test_stream_keys, test_append_matches_full_recompute, test_prefix_results,
+                 test_reload_rebuilds_the_stream, test_too_short_is_value_error, test_tracker_limit):
+        test()
+        print(f"✅ {test.__name__} passed")
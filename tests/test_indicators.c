@@ -1,6 +1,988 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <math.h>
+#include <limits.h>
 #include "indicators.h"
+#include "panel.h"
+#include "threadpool.h"
+#include "price_file.h"
+#include "csv_parser.h"
+#include "series_hash.h"
+#include <string.h>
+#include <time.h>
+
+// compares the rolling SMA against a direct per-window sum over a long, noisy series
+static int check_sma_against_naive(void)
+{
+    int length = 5000;
+    int window = 200;
+    double *prices = malloc(sizeof(double) * length);
+    if (!prices)
+        return 1;
+    for (int i = 0; i < length; i++)
+    {
+        prices[i] = 100.0 + 25.0 * sin(i * 0.01) + (i % 7) * 0.125;
+    }
+
+    double *sma = compute_SMA(prices, length, window);
+    if (!sma)
+    {
+        free(prices);
+        return 1;
+    }
+
+    int failed = 0;
+    for (int i = 0; i < length - window + 1; i++)
+    {
+        double sum = 0.0;
+        for (int j = 0; j < window; j++)
+        {
+            sum += prices[i + j];
+        }
+        if (fabs(sma[i] - sum / window) > 1e-9)
+        {
+            fprintf(stderr, "SMA mismatch at %d: %f vs %f\n", i, sma[i], sum / window);
+            failed = 1;
+            break;
+        }
+    }
+
+    c_free(sma);
+    free(prices);
+    return failed;
+}
+
+// compares the single-pass Bollinger Bands against two-pass mean / standard deviation per window
+static int check_bollinger_against_naive(void)
+{
+    int length = 3000;
+    int window = 20;
+    double width = 2.0;
+    double *prices = malloc(sizeof(double) * length);
+    if (!prices)
+        return 1;
+    for (int i = 0; i < length; i++)
+    {
+        prices[i] = 1000.0 + 3.0 * cos(i * 0.05) + (i % 5) * 0.01;
+    }
+
+    BollingerBands *bands = compute_bollinger_bands(prices, length, window, width);
+    if (!bands)
+    {
+        free(prices);
+        return 1;
+    }
+
+    int failed = 0;
+    for (int i = 0; i < bands->length && !failed; i++)
+    {
+        double sum = 0.0;
+        for (int j = 0; j < window; j++)
+        {
+            sum += prices[i + j];
+        }
+        double mean = sum / window;
+        double m2 = 0.0;
+        for (int j = 0; j < window; j++)
+        {
+            m2 += (prices[i + j] - mean) * (prices[i + j] - mean);
+        }
+        double std_dev = sqrt(m2 / window);
+        if (fabs(bands->middle_band[i] - mean) > 1e-9 ||
+            fabs(bands->top_band[i] - (mean + width * std_dev)) > 1e-9 ||
+            fabs(bands->bottom_band[i] - (mean - width * std_dev)) > 1e-9)
+        {
+            fprintf(stderr, "Bollinger mismatch at %d: top %f vs %f\n", i, bands->top_band[i], mean + width * std_dev);
+            failed = 1;
+        }
+    }
+
+    cleanup_bands(bands);
+    free(prices);
+    return failed;
+}
+
+// seeds each stream from part of a series, pushes the rest and expects the batch values bit for bit
+static int check_streams_against_batch(void)
+{
+    int length = 1500;
+    int warmup = 300;
+    int window = 14;
+    double *prices = malloc(sizeof(double) * length);
+    if (!prices)
+        return 1;
+    for (int i = 0; i < length; i++)
+    {
+        prices[i] = 50.0 + 5.0 * sin(i * 0.07) + (i % 11) * 0.03;
+    }
+    double *sma = compute_SMA(prices, length, window);
+    double *ema = compute_EMA(prices, length, window);
+    double *rsi = compute_RSI(prices, length, window);
+    MACD *macd = compute_MACD(prices, length);
+    SMAStream *sma_stream = init_SMA_stream(prices, warmup, window);
+    EMAStream *ema_stream = init_EMA_stream(prices, warmup, window);
+    RSIStream *rsi_stream = init_RSI_stream(prices, warmup, window);
+    MACDStream *macd_stream = init_MACD_stream(prices, warmup, MACD_FAST_PERIOD, MACD_SLOW_PERIOD, MACD_SIGNAL_PERIOD);
+    int macd_offset = MACD_SLOW_PERIOD + MACD_SIGNAL_PERIOD - 2; // prices index of MACD_Values[0]
+
+    int failed = !sma || !ema || !rsi || !macd || !sma_stream || !ema_stream || !rsi_stream || !macd_stream;
+    for (int i = warmup; i < length && !failed; i++)
+    {
+        double sma_value = update_SMA_stream(sma_stream, prices[i]);
+        double ema_value = update_EMA_stream(ema_stream, prices[i]);
+        double rsi_value = update_RSI_stream(rsi_stream, prices[i]);
+        if (sma_value != sma[i - window + 1] || ema_value != ema[i - window + 1] || rsi_value != rsi[i - window])
+        {
+            fprintf(stderr, "Stream mismatch at %d\n", i);
+            failed = 1;
+        }
+
+        MACDPoint point;
+        update_MACD_stream(macd_stream, prices[i], &point);
+        if (point.MACD_Value != macd->MACD_Values[i - macd_offset] ||
+            point.signal_line_Value != macd->signal_line_Values[i - macd_offset])
+        {
+            fprintf(stderr, "MACD stream mismatch at %d: %.17g %.17g vs %.17g %.17g\n", i, point.MACD_Value, point.signal_line_Value, macd->MACD_Values[i - macd_offset], macd->signal_line_Values[i - macd_offset]);
+            failed = 1;
+        }
+    }
+
+    cleanup_SMA_stream(sma_stream);
+    cleanup_EMA_stream(ema_stream);
+    cleanup_RSI_stream(rsi_stream);
+    cleanup_MACD_stream(macd_stream);
+    cleanup_MACD(macd);
+    c_free(sma);
+    c_free(ema);
+    c_free(rsi);
+    free(prices);
+    return failed;
+}
+
+// appends the rest of a series to streams in uneven blocks and expects the batch values bit for bit
+static int check_stream_appends(void)
+{
+    enum
+    {
+        LENGTH = 1200,
+        WARMUP = 40,
+        WINDOW = 14
+    };
+    static double prices[LENGTH], volumes[LENGTH];
+    static double sma_out[LENGTH], ema_out[LENGTH], rsi_out[LENGTH], obv_out[LENGTH];
+    static double macd_out[3][LENGTH];
+    for (int i = 0; i < LENGTH; i++)
+    {
+        prices[i] = 80.0 + 6.0 * sin(i * 0.05) + (i % 13) * 0.02;
+        volumes[i] = 1e5 + (i % 17) * 250.0;
+    }
+    double *sma = compute_SMA(prices, LENGTH, WINDOW);
+    double *ema = compute_EMA(prices, LENGTH, WINDOW);
+    double *rsi = compute_RSI(prices, LENGTH, WINDOW);
+    double *obv = compute_OBV(prices, volumes, LENGTH);
+    MACD *macd = compute_MACD(prices, LENGTH);
+    SMAStream *sma_stream = init_SMA_stream(prices, WARMUP, WINDOW);
+    EMAStream *ema_stream = init_EMA_stream(prices, WARMUP, WINDOW);
+    RSIStream *rsi_stream = init_RSI_stream(prices, WARMUP, WINDOW);
+    OBVStream *obv_stream = init_OBV_stream(prices, volumes, WARMUP);
+    MACDStream *macd_stream = init_MACD_stream(prices, WARMUP, MACD_FAST_PERIOD, MACD_SLOW_PERIOD, MACD_SIGNAL_PERIOD);
+    int macd_offset = MACD_SLOW_PERIOD + MACD_SIGNAL_PERIOD - 2;
+
+    int failed = !sma || !ema || !rsi || !obv || !macd || !sma_stream || !ema_stream || !rsi_stream || !obv_stream ||
+                 !macd_stream;
+    int block = 0;
+    for (int i = WARMUP; i < LENGTH && !failed; i += block)
+    {
+        block = (block * 7 + 1) % 97; // 1, 8, 57, 12, ...
+        if (block > LENGTH - i)
+            block = LENGTH - i;
+        failed = append_SMA_stream(sma_stream, prices + i, block, sma_out + i) != SUCCESS ||
+                 append_EMA_stream(ema_stream, prices + i, block, ema_out + i) != SUCCESS ||
+                 append_RSI_stream(rsi_stream, prices + i, block, rsi_out + i) != SUCCESS ||
+                 append_OBV_stream(obv_stream, prices + i, volumes + i, block, obv_out + i) != SUCCESS ||
+                 append_MACD_stream(macd_stream, prices + i, block, macd_out[0] + i, macd_out[1] + i,
+                                    macd_out[2] + i) != SUCCESS;
+    }
+    int count = LENGTH - WARMUP;
+    failed = failed || memcmp(sma_out + WARMUP, sma + WARMUP - WINDOW + 1, sizeof(double) * count) != 0 ||
+             memcmp(ema_out + WARMUP, ema + WARMUP - WINDOW + 1, sizeof(double) * count) != 0 ||
+             memcmp(rsi_out + WARMUP, rsi + WARMUP - WINDOW, sizeof(double) * count) != 0 ||
+             memcmp(obv_out + WARMUP, obv + WARMUP, sizeof(double) * count) != 0 ||
+             memcmp(macd_out[0] + WARMUP, macd->MACD_Values + WARMUP - macd_offset, sizeof(double) * count) != 0 ||
+             memcmp(macd_out[1] + WARMUP, macd->signal_line_Values + WARMUP - macd_offset, sizeof(double) * count) != 0;
+    for (int i = WARMUP; i < LENGTH && !failed; i++)
+        failed = macd_out[2][i] != macd_out[0][i] - macd_out[1][i];
+
+    cleanup_SMA_stream(sma_stream);
+    cleanup_EMA_stream(ema_stream);
+    cleanup_RSI_stream(rsi_stream);
+    cleanup_OBV_stream(obv_stream);
+    cleanup_MACD_stream(macd_stream);
+    cleanup_MACD(macd);
+    c_free(sma);
+    c_free(ema);
+    c_free(rsi);
+    c_free(obv);
+    return failed;
+}
+
+// on windows long enough for the vectorized kernels, SMA streams must agree with the batch function
+// within SIMD_RELATIVE_TOLERANCE at the default settings, and bit for bit with set_rolling_simd(0)
+static int check_streams_at_default_simd(void)
+{
+    enum
+    {
+        LENGTH = 3000,
+        WARMUP = 500
+    };
+    static double prices[LENGTH], batch[LENGTH], streamed[LENGTH];
+    int windows[] = {16, 32, 64, 200};
+    double magnitude = 0.0;
+    for (int i = 0; i < LENGTH; i++)
+    {
+        prices[i] = 100.0 + 15.0 * sin(i * 0.013) + (i % 9) * 0.07;
+        if (fabs(prices[i]) > magnitude)
+            magnitude = fabs(prices[i]);
+    }
+
+    int failed = 0;
+    for (int scalar = 0; scalar <= 1 && !failed; scalar++)
+    {
+        int rolling_simd = scalar ? set_rolling_simd(0) : get_rolling_simd();
+        for (size_t w = 0; w < sizeof(windows) / sizeof(windows[0]) && !failed; w++)
+        {
+            int window = windows[w];
+            SMAStream *stream = init_SMA_stream(prices, WARMUP, window);
+            failed = !stream || compute_SMA_into(prices, LENGTH, window, batch) != SUCCESS ||
+                     append_SMA_stream(stream, prices + WARMUP, LENGTH - WARMUP, streamed) != SUCCESS;
+            const double *expected = batch + WARMUP - window + 1;
+            for (int i = 0; i < LENGTH - WARMUP && !failed; i++)
+            {
+                if (scalar ? memcmp(&streamed[i], &expected[i], sizeof(double)) != 0
+                           : fabs(streamed[i] - expected[i]) > SIMD_RELATIVE_TOLERANCE * magnitude)
+                    failed = 1;
+            }
+            if (failed)
+                fprintf(stderr, "SMA stream differs from batch (rolling SIMD %s, SIMD level %d), window %d\n",
+                        get_rolling_simd() ? "on" : "off", get_simd_level(), window);
+            cleanup_SMA_stream(stream);
+        }
+        set_rolling_simd(rolling_simd);
+    }
+    return failed;
+}
+
+// runs SMA and Bollinger Bands on every SIMD level the CPU supports and compares against scalar
+static int check_simd_against_scalar(void)
+{
+    enum
+    {
+        LENGTH = 4000
+    };
+    static double prices[LENGTH];
+    static double expected[4][LENGTH];
+    static double actual[4][LENGTH];
+    int windows[] = {13, 16, 20, 31, 32, 64, 200}; // below, at and above the vector thresholds
+    int detected = get_simd_level();
+    int rolling_simd = set_rolling_simd(1);
+
+    double price = 100.0;
+    double magnitude = 0.0;
+    for (int i = 0; i < LENGTH; i++)
+    {
+        price += sin(i * 0.37) + cos(i * 0.011) * 0.5;
+        prices[i] = price;
+        if (fabs(price) > magnitude)
+            magnitude = fabs(price);
+    }
+
+    int failed = 0;
+    for (int level = SIMD_AVX2; level <= detected && !failed; level++)
+    {
+        for (size_t w = 0; w < sizeof(windows) / sizeof(windows[0]) && !failed; w++)
+        {
+            int window = windows[w];
+            int result_length = LENGTH - window + 1;
+
+            set_simd_level(SIMD_SCALAR);
+            compute_SMA_into(prices, LENGTH, window, expected[0]);
+            compute_bollinger_bands_into(prices, LENGTH, window, 2.0, expected[1], expected[2], expected[3]);
+            set_simd_level(level);
+            compute_SMA_into(prices, LENGTH, window, actual[0]);
+            compute_bollinger_bands_into(prices, LENGTH, window, 2.0, actual[1], actual[2], actual[3]);
+
+            for (int k = 0; k < 4 && !failed; k++)
+            {
+                for (int i = 0; i < result_length; i++)
+                {
+                    if (fabs(actual[k][i] - expected[k][i]) > SIMD_RELATIVE_TOLERANCE * magnitude)
+                    {
+                        fprintf(stderr, "SIMD level %d mismatch (window %d, output %d) at %d: %.17g vs %.17g\n",
+                                level, window, k, i, actual[k][i], expected[k][i]);
+                        failed = 1;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    set_simd_level(detected);
+    set_rolling_simd(rolling_simd);
+    return failed;
+}
+
+// the interleaved kernels must match the single-series functions bit for bit at every SIMD level
+static int check_interleaved_against_series(void)
+{
+    enum
+    {
+        SYMBOLS = 21, // two 8-lane blocks, one 4-lane block and a scalar leftover
+        LENGTH = 400,
+        WINDOW = 14
+    };
+    static double prices[LENGTH * SYMBOLS];
+    static double series[LENGTH];
+    static double ema[LENGTH * SYMBOLS];
+    static double rsi[LENGTH * SYMBOLS];
+    static double macd[3][LENGTH * SYMBOLS];
+    static double expected[3][LENGTH];
+    for (int t = 0; t < LENGTH; t++)
+    {
+        for (int s = 0; s < SYMBOLS; s++)
+        {
+            prices[t * SYMBOLS + s] = 10.0 + s + sin(t * (0.05 + 0.01 * s)) + ((t + s) % 4 == 0 ? 0.0 : 0.25);
+        }
+    }
+
+    int detected = get_simd_level();
+    int failed = 0;
+    for (int level = SIMD_SCALAR; level <= detected && !failed; level++)
+    {
+        set_simd_level(level);
+        if (compute_EMA_interleaved(prices, SYMBOLS, SYMBOLS, LENGTH, WINDOW, ema) != SUCCESS ||
+            compute_RSI_interleaved(prices, SYMBOLS, SYMBOLS, LENGTH, WINDOW, rsi) != SUCCESS ||
+            compute_MACD_interleaved(prices, SYMBOLS, SYMBOLS, LENGTH, MACD_FAST_PERIOD, MACD_SLOW_PERIOD,
+                                     MACD_SIGNAL_PERIOD, macd[0], macd[1], macd[2]) != SUCCESS)
+        {
+            failed = 1;
+            break;
+        }
+
+        for (int s = 0; s < SYMBOLS && !failed; s++)
+        {
+            for (int t = 0; t < LENGTH; t++)
+            {
+                series[t] = prices[t * SYMBOLS + s];
+            }
+            int macd_length = compute_output_length(INDICATOR_MACD, LENGTH, 0);
+            compute_MACD_periods_into(series, LENGTH, MACD_FAST_PERIOD, MACD_SLOW_PERIOD, MACD_SIGNAL_PERIOD,
+                                      expected[0], expected[1], expected[2]);
+            for (int i = 0; i < macd_length; i++)
+            {
+                for (int p = 0; p < 3; p++)
+                {
+                    if (macd[p][i * SYMBOLS + s] != expected[p][i])
+                        failed = 1;
+                }
+            }
+
+            compute_EMA_into(series, LENGTH, WINDOW, expected[0]);
+            compute_RSI_into(series, LENGTH, WINDOW, expected[1]);
+            for (int i = 0; i < LENGTH - WINDOW; i++)
+            {
+                if (ema[i * SYMBOLS + s] != expected[0][i] || rsi[i * SYMBOLS + s] != expected[1][i])
+                    failed = 1;
+            }
+            if (ema[(LENGTH - WINDOW) * SYMBOLS + s] != expected[0][LENGTH - WINDOW])
+                failed = 1;
+            if (failed)
+                fprintf(stderr, "Interleaved mismatch at SIMD level %d, symbol %d\n", level, s);
+        }
+    }
+
+    set_simd_level(detected);
+    return failed;
+}
+
+// an indicator set with shared and duplicate specs must match computing each spec on its own
+static int check_indicator_set(void)
+{
+    enum
+    {
+        LENGTH = 600,
+        SPECS = 9
+    };
+    static double prices[LENGTH];
+    static double volumes[LENGTH];
+    static double set_out[SPECS][3 * LENGTH];
+    static double single_out[3 * LENGTH];
+    for (int i = 0; i < LENGTH; i++)
+    {
+        prices[i] = 75.0 + 4.0 * sin(i * 0.09) + (i % 6) * 0.2;
+        volumes[i] = 1000.0 + (i % 13) * 10.0;
+    }
+
+    IndicatorSpec specs[SPECS] = {
+        {INDICATOR_SMA, 20, 0, 0, 0, 0},
+        {INDICATOR_RSI, 14, 0, 0, 0, 0},
+        {INDICATOR_BOLLINGER, 20, 2.0, 0, 0, 0},
+        {INDICATOR_EMA, 12, 0, 0, 0, 0},
+        {INDICATOR_OBV, 0, 0, 0, 0, 0},
+        {INDICATOR_SMA, 20, 0, 0, 0, 0},
+        {INDICATOR_MACD, 0, 0, MACD_FAST_PERIOD, MACD_SLOW_PERIOD, MACD_SIGNAL_PERIOD},
+        {INDICATOR_RSI, 14, 0, 0, 0, 0},
+        {INDICATOR_BOLLINGER, 20, 3.0, 0, 0, 0},
+    };
+    double *outs[SPECS];
+    for (int k = 0; k < SPECS; k++)
+    {
+        outs[k] = set_out[k];
+    }
+    if (compute_indicator_set(specs, SPECS, prices, volumes, LENGTH, outs) != SUCCESS)
+        return 1;
+
+    for (int k = 0; k < SPECS; k++)
+    {
+        size_t bytes = sizeof(double) * indicator_output_planes(specs[k].type) * LENGTH;
+        compute_indicator_aligned(&specs[k], prices, volumes, LENGTH, single_out, LENGTH);
+        if (memcmp(set_out[k], single_out, bytes) != 0)
+        {
+            fprintf(stderr, "Indicator set mismatch for spec %d\n", k);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// writes a price file, maps it back and runs indicators straight on its columns
+static int check_price_file(void)
+{
+    enum
+    {
+        ROWS = 250
+    };
+    const char *path = "test_prices.tmp";
+    static int64_t timestamps[ROWS];
+    static double open[ROWS], high[ROWS], low[ROWS], close[ROWS], volume[ROWS];
+    for (int i = 0; i < ROWS; i++)
+    {
+        timestamps[i] = 1700000000 + (int64_t)i * 86400;
+        close[i] = 150.0 + 10.0 * sin(i * 0.1);
+        open[i] = close[i] - 0.5;
+        high[i] = close[i] + 1.0;
+        low[i] = close[i] - 1.0;
+        volume[i] = 1e6 + i;
+    }
+    if (write_price_file(path, "AAPL", ROWS, timestamps, open, high, low, close, volume) != SUCCESS)
+        return 1;
+
+    PriceFile *file = open_price_file(path);
+    remove(path); // the mapping outlives the directory entry
+    if (!file)
+        return 1;
+
+    int failed = file->rows != ROWS || strcmp(file->symbol, "AAPL") != 0 ||
+                 memcmp(file->timestamps, timestamps, sizeof(timestamps)) != 0 ||
+                 memcmp(file->close, close, sizeof(close)) != 0 || memcmp(file->volume, volume, sizeof(volume)) != 0;
+
+    // days 10 .. 19 inclusive, with bounds falling between and on bars
+    int first = -1;
+    int count = price_file_range(file, timestamps[10] - 1, timestamps[19], &first);
+    if (first != 10 || count != 10 || price_file_range(file, timestamps[ROWS - 1] + 1, timestamps[ROWS - 1] + 2, &first) != 0)
+        failed = 1;
+
+    double *from_file = compute_SMA((double *)file->close, file->rows, 20);
+    double *from_array = compute_SMA(close, ROWS, 20);
+    if (!from_file || !from_array || memcmp(from_file, from_array, sizeof(double) * (ROWS - 19)) != 0)
+        failed = 1;
+
+    c_free(from_file);
+    c_free(from_array);
+    close_price_file(file);
+    return failed;
+}
+
+// rewrites the byte order marker of a price file and reports whether it still opens
+static int opens_with_byte_order(const char *path, uint32_t byte_order)
+{
+    FILE *f = fopen(path, "r+b");
+    if (!f)
+        return -1;
+    int written = fseek(f, (long)offsetof(PriceFileHeader, byte_order), SEEK_SET) == 0 &&
+                  fwrite(&byte_order, sizeof(byte_order), 1, f) == 1;
+    fclose(f);
+    if (!written)
+        return -1;
+    PriceFile *file = open_price_file(path);
+    close_price_file(file);
+    return file != NULL;
+}
+
+// a file written on a machine of the other byte order is rejected; one from before the marker is not
+static int check_price_file_byte_order(void)
+{
+    const char *path = "test_byte_order.tmp";
+    int64_t timestamps[3] = {1700000000, 1700086400, 1700172800};
+    double values[3] = {1.0, 2.0, 3.0};
+    if (write_price_file(path, "AAPL", 3, timestamps, values, values, values, values, values) != SUCCESS)
+        return 1;
+
+    int failed = opens_with_byte_order(path, PRICE_FILE_BYTE_ORDER) != 1 || opens_with_byte_order(path, 0) != 1 ||
+                 opens_with_byte_order(path, 0x04030201u) != 0 || opens_with_byte_order(path, 0xDEADBEEFu) != 0;
+    remove(path);
+    return failed;
+}
+
+static int same_double(double a, double b)
+{
+    return memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+// parses a newest-first vendor CSV serially and on a pool and checks every value against strtod()
+static int check_csv_parser(void)
+{
+    enum
+    {
+        ROWS = 20000,
+        LINE = 96
+    };
+    char *csv = malloc((size_t)ROWS * LINE + 128);
+    int64_t *timestamps = malloc(sizeof(int64_t) * ROWS);
+    double *expected = malloc(sizeof(double) * 5 * ROWS);
+    ThreadPool *pool = init_thread_pool(3);
+    if (!csv || !timestamps || !expected || !pool)
+        return 1;
+
+    size_t size = (size_t)sprintf(csv, "timestamp,open,high,low,close,volume,dividend\r\n");
+    for (int i = ROWS - 1; i >= 0; i--)
+    {
+        timestamps[i] = 946684800 + (int64_t)i * 86400; // daily from 2000-01-01
+        time_t t = (time_t)timestamps[i];
+        char date[16];
+        strftime(date, sizeof(date), "%Y-%m-%d", gmtime(&t));
+        char fields[5][24];
+        double close = 100.0 + 40.0 * sin(i * 0.01);
+        sprintf(fields[0], "%.2f", close - 0.37);
+        sprintf(fields[1], "%.4f", close + 1.0 / 3.0);
+        sprintf(fields[2], "%.17g", close - 1.0 / 7.0);
+        sprintf(fields[3], "%.6f", close);
+        sprintf(fields[4], "%d", 1000000 + i * 37);
+        for (int f = 0; f < 5; f++)
+            expected[f * ROWS + i] = strtod(fields[f], NULL);
+        size += (size_t)sprintf(csv + size, "%s,%s,%s,%s,%s,%s,0.0000\r\n", date, fields[0], fields[1], fields[2],
+                                fields[3], fields[4]);
+        if (i == ROWS / 2)
+            size += (size_t)sprintf(csv + size, "\r\n");
+    }
+
+    int failed = 0;
+    ThreadPool *pools[2] = {NULL, pool};
+    for (int p = 0; p < 2; p++)
+    {
+        PriceColumns *columns = parse_price_csv_buffer(csv, size, pools[p]);
+        if (!columns || columns->rows != ROWS || columns->fields != 0x1f ||
+            memcmp(columns->timestamps, timestamps, sizeof(int64_t) * ROWS) != 0)
+        {
+            failed = 1;
+        }
+        else
+        {
+            const double *parsed[5] = {columns->open, columns->high, columns->low, columns->close, columns->volume};
+            for (int f = 0; f < 5; f++)
+                failed |= memcmp(parsed[f], expected + f * ROWS, sizeof(double) * ROWS) != 0;
+        }
+        free_price_columns(columns);
+    }
+
+    // numbers off the fast path, a missing column and an empty field
+    const char *unusual = "Date,Close\n"
+                          "2024-01-03 16:00,1.2345678901234567890123\n"
+                          "2024-01-02,\n"
+                          "1704412800,-1e-30\n"
+                          "2024-01-04T09:30:15,\"  7.5e+3 \"\n";
+    PriceColumns *columns = parse_price_csv_buffer(unusual, strlen(unusual), NULL);
+    if (!columns || columns->rows != 4 || columns->fields != 1u << 3)
+        failed = 1;
+    else
+    {
+        const int64_t times[4] = {1704153600, 1704297600, 1704360615, 1704412800};
+        failed |= memcmp(columns->timestamps, times, sizeof(times)) != 0 || !isnan(columns->close[0]) ||
+                  !same_double(columns->close[1], strtod("1.2345678901234567890123", NULL)) ||
+                  !same_double(columns->close[2], 7500.0) || !same_double(columns->close[3], -1e-30) ||
+                  !isnan(columns->open[0]);
+    }
+    free_price_columns(columns);
+
+    // commas inside quoted fields do not split them
+    const char *quoted = "\"date\",note,\"close\"\n"
+                         "\"2024-01-02\",\"split, 2:1 \"\"adjusted\"\"\",\"12.5\"\n"
+                         "2024-01-03,,13\n";
+    columns = parse_price_csv_buffer(quoted, strlen(quoted), NULL);
+    failed |= !columns || columns->rows != 2 || columns->timestamps[0] != 1704153600 ||
+              !same_double(columns->close[0], 12.5) || !same_double(columns->close[1], 13.0);
+    free_price_columns(columns);
+
+    // a quoted field spanning lines is not supported; the row must be rejected, not mis-split
+    const char *multiline = "date,note,close\n2024-01-02,\"two\nlines\",12.5\n";
+    if (parse_price_csv_buffer(multiline, strlen(multiline), NULL) != NULL)
+        failed = 1;
+
+    const char *malformed = "date,close\n2024-01-02,12.5x\n";
+    if (parse_price_csv_buffer(malformed, strlen(malformed), NULL) != NULL)
+        failed = 1;
+
+    // days past the end of the month are rejected, with February following the Gregorian leap years
+    const char *invalid_dates[] = {"2024-02-30", "2023-02-29", "2100-02-29", "2023-04-31", "2023-11-31"};
+    for (size_t d = 0; d < sizeof(invalid_dates) / sizeof(invalid_dates[0]); d++)
+    {
+        char text[64];
+        int length = sprintf(text, "date,close\n%s,1\n", invalid_dates[d]);
+        PriceColumns *rejected = parse_price_csv_buffer(text, (size_t)length, NULL);
+        if (rejected)
+        {
+            fprintf(stderr, "Accepted invalid date %s\n", invalid_dates[d]);
+            free_price_columns(rejected);
+            failed = 1;
+        }
+    }
+    const char *month_ends = "date,close\n2024-02-29,1\n2000-02-29,2\n2023-02-28,3\n2023-12-31,4\n";
+    columns = parse_price_csv_buffer(month_ends, strlen(month_ends), NULL);
+    const int64_t month_end_times[4] = {951782400, 1677542400, 1703980800, 1709164800}; // sorted
+    failed |= !columns || columns->rows != 4 || memcmp(columns->timestamps, month_end_times, sizeof(month_end_times)) != 0;
+    free_price_columns(columns);
+
+    cleanup_thread_pool(pool);
+    free(csv);
+    free(timestamps);
+    free(expected);
+    return failed;
+}
+
+// equal series hash alike; any changed bit, length or seed changes the hash
+static int check_series_hash(void)
+{
+    enum
+    {
+        LENGTH = 1001
+    };
+    static double a[LENGTH], b[LENGTH];
+    for (int i = 0; i < LENGTH; i++)
+        a[i] = b[i] = 100.0 + sin(i * 0.1);
+
+    uint64_t hash = hash_series(a, LENGTH, 0);
+    int failed = hash != hash_series(b, LENGTH, 0) || hash == hash_series(a, LENGTH - 1, 0) ||
+                 hash == hash_series(a, LENGTH, 1) || hash_series(NULL, 0, 0) == hash_series(a, 1, 0);
+    for (int i = 0; i < LENGTH && !failed; i += 97)
+    {
+        b[i] = nextafter(a[i], INFINITY); // flips the lowest mantissa bit
+        failed = hash_series(b, LENGTH, 0) == hash;
+        b[i] = a[i];
+    }
+    b[3] = -0.0;
+    a[3] = 0.0;
+    failed |= hash_series(a, LENGTH, 0) == hash_series(b, LENGTH, 0);
+    return failed;
+}
+
+// computes a panel in both layouts and checks every symbol against the single-series functions
+static int check_panel_against_series(void)
+{
+    enum
+    {
+        SYMBOLS = 11,
+        TIME_STEPS = 120
+    };
+    static double rows[SYMBOLS * TIME_STEPS];
+    static double columns[SYMBOLS * TIME_STEPS];
+    static double row_out[3 * SYMBOLS * TIME_STEPS];
+    static double column_out[3 * SYMBOLS * TIME_STEPS];
+    int lengths[SYMBOLS];
+    for (int s = 0; s < SYMBOLS; s++)
+    {
+        lengths[s] = TIME_STEPS - 9 * s; // the last symbols are too short for MACD
+        for (int t = 0; t < TIME_STEPS; t++)
+        {
+            double price = 20.0 + s + sin((t + 3 * s) * 0.2);
+            rows[s * TIME_STEPS + t] = price;
+            columns[t * SYMBOLS + s] = price;
+        }
+    }
+
+    PricePanel row_panel = {rows, NULL, lengths, SYMBOLS, TIME_STEPS, PANEL_ROW_MAJOR};
+    PricePanel column_panel = {columns, NULL, lengths, SYMBOLS, TIME_STEPS, PANEL_COLUMN_MAJOR};
+    IndicatorSpec sma_spec = {INDICATOR_SMA, 10, 0, 0, 0, 0};
+    IndicatorSpec macd_spec = {INDICATOR_MACD, 0, 0, MACD_FAST_PERIOD, MACD_SLOW_PERIOD, MACD_SIGNAL_PERIOD};
+
+    if (compute_panel(&row_panel, &sma_spec, row_out) != SUCCESS ||
+        compute_panel(&column_panel, &sma_spec, column_out) != SUCCESS)
+        return 1;
+    for (int s = 0; s < SYMBOLS; s++)
+    {
+        double *sma = compute_SMA(rows + s * TIME_STEPS, lengths[s], sma_spec.window);
+        for (int t = 0; t < TIME_STEPS; t++)
+        {
+            double expected = (t >= sma_spec.window - 1 && t < lengths[s]) ? sma[t - sma_spec.window + 1] : NAN;
+            double row_value = row_out[s * TIME_STEPS + t];
+            double column_value = column_out[t * SYMBOLS + s];
+            if (isnan(expected) ? !(isnan(row_value) && isnan(column_value)) : (row_value != expected || column_value != expected))
+            {
+                fprintf(stderr, "Panel SMA mismatch at symbol %d, t %d\n", s, t);
+                c_free(sma);
+                return 1;
+            }
+        }
+        c_free(sma);
+    }
+
+    if (compute_panel(&row_panel, &macd_spec, row_out) != SUCCESS ||
+        compute_panel(&column_panel, &macd_spec, column_out) != SUCCESS)
+        return 1;
+    for (int s = 0; s < SYMBOLS; s++)
+    {
+        MACD *macd = compute_MACD(rows + s * TIME_STEPS, lengths[s]);
+        int lead = indicator_lead(&macd_spec);
+        for (int t = 0; t < TIME_STEPS; t++)
+        {
+            double expected = (macd && t >= lead && t < lengths[s]) ? macd->histogram_Values[t - lead] : NAN;
+            double row_value = row_out[2 * SYMBOLS * TIME_STEPS + s * TIME_STEPS + t];
+            double column_value = column_out[2 * SYMBOLS * TIME_STEPS + t * SYMBOLS + s];
+            if (isnan(expected) ? !(isnan(row_value) && isnan(column_value)) : (row_value != expected || column_value != expected))
+            {
+                fprintf(stderr, "Panel MACD mismatch at symbol %d, t %d\n", s, t);
+                cleanup_MACD(macd);
+                return 1;
+            }
+        }
+        if (macd)
+            cleanup_MACD(macd);
+    }
+    return 0;
+}
+
+// the thread pool must reproduce the serial panel results exactly, in both layouts
+static int check_parallel_panel(void)
+{
+    enum
+    {
+        SYMBOLS = 300,
+        TIME_STEPS = 90
+    };
+    static double rows[SYMBOLS * TIME_STEPS];
+    static double columns[SYMBOLS * TIME_STEPS];
+    static double serial[3 * SYMBOLS * TIME_STEPS];
+    static double parallel[4][3 * SYMBOLS * TIME_STEPS];
+    int lengths[SYMBOLS];
+    for (int s = 0; s < SYMBOLS; s++)
+    {
+        lengths[s] = TIME_STEPS - s % 60;
+        for (int t = 0; t < TIME_STEPS; t++)
+        {
+            double price = 80.0 + cos((t + s) * 0.13) * (1 + s % 5);
+            rows[s * TIME_STEPS + t] = price;
+            columns[t * SYMBOLS + s] = price;
+        }
+    }
+
+    IndicatorSpec specs[4] = {
+        {INDICATOR_SMA, 20, 0, 0, 0, 0},
+        {INDICATOR_RSI, 14, 0, 0, 0, 0},
+        {INDICATOR_BOLLINGER, 20, 2.0, 0, 0, 0},
+        {INDICATOR_MACD, 0, 0, MACD_FAST_PERIOD, MACD_SLOW_PERIOD, MACD_SIGNAL_PERIOD}};
+    double *outs[4] = {parallel[0], parallel[1], parallel[2], parallel[3]};
+    ThreadPool *pool = init_thread_pool(3);
+    if (!pool)
+        return 1;
+
+    int failed = 0;
+    for (int layout = 0; layout < 2 && !failed; layout++)
+    {
+        PricePanel panel = {layout ? columns : rows, NULL, lengths, SYMBOLS, TIME_STEPS, layout ? PANEL_COLUMN_MAJOR : PANEL_ROW_MAJOR};
+        if (compute_panel_parallel(pool, &panel, specs, 4, outs) != SUCCESS)
+        {
+            failed = 1;
+            break;
+        }
+        for (int k = 0; k < 4 && !failed; k++)
+        {
+            size_t size = sizeof(double) * indicator_output_planes(specs[k].type) * SYMBOLS * TIME_STEPS;
+            if (compute_panel(&panel, &specs[k], serial) != SUCCESS || memcmp(serial, parallel[k], size) != 0)
+            {
+                fprintf(stderr, "Parallel panel mismatch for indicator %d, layout %d\n", k, layout);
+                failed = 1;
+            }
+        }
+    }
+
+    cleanup_thread_pool(pool);
+    return failed;
+}
+
+// caller-sized MACD buffers: compute_MACD_into fills exactly compute_output_length values,
+// the last of which belongs to the last price
+static int check_macd_into_bounds(void)
+{
+    enum
+    {
+        LENGTH = 200,
+        GUARD = 4
+    };
+    const double canary = -12345.0;
+    double prices[LENGTH];
+    double macd[LENGTH + GUARD];
+    double signal[LENGTH + GUARD];
+    for (int i = 0; i < LENGTH; i++)
+    {
+        prices[i] = 20.0 + 3.0 * sin(i * 0.2) + (i % 5) * 0.1;
+    }
+    for (int i = 0; i < LENGTH + GUARD; i++)
+    {
+        macd[i] = canary;
+        signal[i] = canary;
+    }
+
+    int result_length = compute_output_length(INDICATOR_MACD, LENGTH, 0);
+    if (result_length != LENGTH - 26 - 9 + 2 || compute_MACD_into(prices, LENGTH, macd, signal) != SUCCESS)
+        return 1;
+    int failed = 0;
+    for (int i = result_length; i < LENGTH + GUARD; i++)
+    {
+        if (macd[i] != canary || signal[i] != canary)
+            failed = 1;
+    }
+
+    double *ema_fast = compute_EMA(prices, LENGTH, 12);
+    double *ema_slow = compute_EMA(prices, LENGTH, 26);
+    if (!ema_fast || !ema_slow)
+        failed = 1;
+    else if (fabs(macd[result_length - 1] - (ema_fast[LENGTH - 12] - ema_slow[LENGTH - 26])) > 1e-12)
+        failed = 1;
+    c_free(ema_fast);
+    c_free(ema_slow);
+    return failed;
+}
+
+// MACD output lengths: huge caller-supplied periods are rejected rather than overflowing
+static int check_macd_output_length_limits(void)
+{
+    return compute_MACD_output_length(100, 12, 26, 9) != 100 - 26 - 9 + 2 ||
+           compute_MACD_output_length(35, 12, 26, 9) != 2 || compute_MACD_output_length(33, 12, 26, 9) != -1 ||
+           compute_MACD_output_length(100, 12, INT_MAX, 9) != -1 ||
+           compute_MACD_output_length(100, 12, 26, INT_MAX) != -1 ||
+           compute_MACD_output_length(INT_MAX, 12, INT_MAX - 1, INT_MAX - 1) != -1 ||
+           compute_MACD_output_length(INT_MAX, 1, 2, 1) != INT_MAX - 1 ||
+           compute_MACD_output_length(-5, 12, 26, 9) != -1;
+}
+
+// the struct and its three arrays share one block, the histogram is MACD - signal bit for bit, and
+// custom periods match the MACD stream seeded with the same periods
+static int check_macd_periods(void)
+{
+    enum
+    {
+        LENGTH = 600
+    };
+    static double prices[LENGTH];
+    const int periods[][3] = {{MACD_FAST_PERIOD, MACD_SLOW_PERIOD, MACD_SIGNAL_PERIOD}, {5, 35, 5}, {3, 10, 16}};
+    for (int i = 0; i < LENGTH; i++)
+    {
+        prices[i] = 60.0 + 8.0 * sin(i * 0.03) + (i % 6) * 0.05;
+    }
+
+    int failed = 0;
+    for (size_t p = 0; p < sizeof(periods) / sizeof(periods[0]) && !failed; p++)
+    {
+        int fast = periods[p][0], slow = periods[p][1], signal = periods[p][2];
+        int offset = slow + signal - 2; // prices index of the first output
+        MACD *macd = compute_MACD_periods(prices, LENGTH, fast, slow, signal);
+        MACDStream *stream = init_MACD_stream(prices, offset + 1, fast, slow, signal);
+        failed = !macd || !stream || macd->length != compute_MACD_output_length(LENGTH, fast, slow, signal) ||
+                 macd->MACD_Values != (double *)(macd + 1) ||
+                 macd->signal_line_Values != macd->MACD_Values + macd->length ||
+                 macd->histogram_Values != macd->signal_line_Values + macd->length;
+
+        for (int i = 0; i < (failed ? 0 : macd->length); i++)
+        {
+            MACDPoint point;
+            if (i > 0)
+                update_MACD_stream(stream, prices[offset + i], &point);
+            else
+                get_MACD_stream_point(stream, &point);
+            if (macd->histogram_Values[i] != macd->MACD_Values[i] - macd->signal_line_Values[i] ||
+                point.MACD_Value != macd->MACD_Values[i] || point.signal_line_Value != macd->signal_line_Values[i] ||
+                point.histogram_Value != macd->histogram_Values[i])
+            {
+                fprintf(stderr, "MACD (%d, %d, %d) mismatch at %d\n", fast, slow, signal, i);
+                failed = 1;
+                break;
+            }
+        }
+        cleanup_MACD_stream(stream);
+        if (macd && cleanup_MACD(macd) != EXIT_SUCCESS) // releases the whole block; the sanitizer run checks for leaks
+            failed = 1;
+    }
+    return failed;
+}
+
+// compares RSI against a textbook Wilder RSI built from explicit gain / loss arrays, then checks the
+// shortest valid series (one output) and that too-short series are rejected instead of exiting
+static int check_rsi_against_naive(void)
+{
+    enum
+    {
+        LENGTH = 800,
+        WINDOW = 14
+    };
+    static double prices[LENGTH], gains[LENGTH], losses[LENGTH], rsi[LENGTH];
+    for (int i = 0; i < LENGTH; i++)
+    {
+        prices[i] = (i < 60) ? 30.0 + i * 0.25 : 40.0 + 6.0 * sin(i * 0.09) + (i % 4) * 0.2; // rising start: RSI 100
+        if (i > 0)
+        {
+            double change = prices[i] - prices[i - 1];
+            gains[i] = (change > 0) ? change : 0.0;
+            losses[i] = (change < 0) ? -change : 0.0;
+        }
+    }
+    if (compute_RSI_into(prices, LENGTH, WINDOW, rsi) != SUCCESS)
+        return 1;
+
+    int failed = 0;
+    double avg_gain = 0.0;
+    double avg_loss = 0.0;
+    for (int i = 1; i <= WINDOW; i++)
+    {
+        avg_gain += gains[i] / WINDOW;
+        avg_loss += losses[i] / WINDOW;
+    }
+    for (int i = WINDOW; i < LENGTH && !failed; i++)
+    {
+        if (i > WINDOW)
+        {
+            avg_gain = (avg_gain * (WINDOW - 1) + gains[i]) / WINDOW;
+            avg_loss = (avg_loss * (WINDOW - 1) + losses[i]) / WINDOW;
+        }
+        double expected = (avg_loss == 0.0) ? 100.0 : 100.0 * avg_gain / (avg_gain + avg_loss);
+        if (fabs(rsi[i - WINDOW] - expected) > 1e-9)
+        {
+            fprintf(stderr, "RSI mismatch at %d: %.17g vs %.17g\n", i, rsi[i - WINDOW], expected);
+            failed = 1;
+        }
+    }
+
+    // window + 1 prices give exactly one value, the same as the first one of the full series
+    double shortest[2] = {-1.0, -1.0};
+    failed |= compute_output_length(INDICATOR_RSI, WINDOW + 1, WINDOW) != 1 ||
+              compute_RSI_into(prices, WINDOW + 1, WINDOW, shortest) != SUCCESS || shortest[0] != rsi[0] ||
+              shortest[1] != -1.0;
+
+    // too short or no window: FAILURE / NULL, and the process carries on
+    failed |= compute_output_length(INDICATOR_RSI, WINDOW, WINDOW) != -1 ||
+              compute_RSI_into(prices, WINDOW, WINDOW, shortest) != FAILURE ||
+              compute_RSI(prices, WINDOW, WINDOW) != NULL || compute_RSI(prices, 3, WINDOW) != NULL ||
+              compute_RSI(prices, LENGTH, 0) != NULL;
+    return failed;
+}
 
 int main()
 {
@@ -23,5 +1005,131 @@ int main()
     printf("\n");
 
     c_free(sma);
+
+    if (check_sma_against_naive())
+    {
+        fprintf(stderr, "SMA naive comparison failed\n");
+        return 1;
+    }
+    printf("SMA naive comparison passed\n");
+
+    if (check_bollinger_against_naive())
+    {
+        fprintf(stderr, "Bollinger naive comparison failed\n");
+        return 1;
+    }
+    printf("Bollinger naive comparison passed\n");
+
+    if (check_macd_into_bounds())
+    {
+        fprintf(stderr, "MACD buffer bounds check failed\n");
+        return 1;
+    }
+    printf("MACD buffer bounds check passed\n");
+
+    if (check_macd_output_length_limits())
+    {
+        fprintf(stderr, "MACD output length limits check failed\n");
+        return 1;
+    }
+    printf("MACD output length limits check passed\n");
+
+    if (check_macd_periods())
+    {
+        fprintf(stderr, "MACD periods comparison failed\n");
+        return 1;
+    }
+    printf("MACD periods comparison passed\n");
+
+    if (check_rsi_against_naive())
+    {
+        fprintf(stderr, "RSI naive comparison failed\n");
+        return 1;
+    }
+    printf("RSI naive comparison passed\n");
+
+    if (check_streams_against_batch())
+    {
+        fprintf(stderr, "Streaming comparison failed\n");
+        return 1;
+    }
+    printf("Streaming comparison passed\n");
+
+    if (check_stream_appends())
+    {
+        fprintf(stderr, "Stream append comparison failed\n");
+        return 1;
+    }
+    printf("Stream append comparison passed\n");
+
+    if (check_streams_at_default_simd())
+    {
+        fprintf(stderr, "Default SIMD stream comparison failed\n");
+        return 1;
+    }
+    printf("Default SIMD stream comparison passed\n");
+
+    if (check_simd_against_scalar())
+    {
+        fprintf(stderr, "SIMD comparison failed\n");
+        return 1;
+    }
+    printf("SIMD comparison passed\n");
+
+    if (check_interleaved_against_series())
+    {
+        fprintf(stderr, "Interleaved comparison failed\n");
+        return 1;
+    }
+    printf("Interleaved comparison passed\n");
+
+    if (check_indicator_set())
+    {
+        fprintf(stderr, "Indicator set comparison failed\n");
+        return 1;
+    }
+    printf("Indicator set comparison passed\n");
+
+    if (check_price_file())
+    {
+        fprintf(stderr, "Price file round trip failed\n");
+        return 1;
+    }
+    printf("Price file round trip passed\n");
+
+    if (check_price_file_byte_order())
+    {
+        fprintf(stderr, "Price file byte order check failed\n");
+        return 1;
+    }
+    printf("Price file byte order check passed\n");
+
+    if (check_csv_parser())
+    {
+        fprintf(stderr, "CSV parser comparison failed\n");
+        return 1;
+    }
+    printf("CSV parser comparison passed\n");
+
+    if (check_series_hash())
+    {
+        fprintf(stderr, "Series hash check failed\n");
+        return 1;
+    }
+    printf("Series hash check passed\n");
+
+    if (check_panel_against_series())
+    {
+        fprintf(stderr, "Panel comparison failed\n");
+        return 1;
+    }
+    printf("Panel comparison passed\n");
+
+    if (check_parallel_panel())
+    {
+        fprintf(stderr, "Parallel panel comparison failed\n");
+        return 1;
+    }
+    printf("Parallel panel comparison passed\n");
     return 0;
 }
@@ -0,0 +1,108 @@
+import os
+import sys
+import tempfile
+import numpy as np
+
+# backend modules import each other by module name, as when the app runs from backend/
+sys.path.append(os.path.abspath(os.path.join(os.path.dirname(__file__), '..', 'backend')))
+
+from wrapper import PRICE_FILE_FIELDS, write_price_file
+from utils.load_prices import PriceStore
+
+DAYS = np.datetime64("2024-01-01") + np.arange(40).astype("timedelta64[D]")
+CLOSE = 100.0 + np.arange(40) * 0.25
+
+def write_csv(path, days, close, reverse=False):
+    # Alpha Vantage order is newest first
+    rows = [(str(day), float(value)) for day, value in zip(days, close)]
+    with open(path, "w") as f:
+        f.write("timestamp,open,high,low,close,volume\n")
+        for day, value in (reversed(rows) if reverse else rows):
+            f.write(f"{day},{value!r},{value + 1!r},{value - 1!r},{value!r},1000\n")
+
+def make_store():
+    data_dir = tempfile.mkdtemp()
+    write_csv(os.path.join(data_dir, "aaa.csv"), DAYS, CLOSE, reverse=True)
+    write_csv(os.path.join(data_dir, "BBB.csv"), DAYS, CLOSE + 1000.0) # shadowed by BBB.prices
+    columns = {name: CLOSE * 2.0 for name in PRICE_FILE_FIELDS}
+    write_price_file(os.path.join(data_dir, "BBB.prices"), "BBB", DAYS, columns)
+    open(os.path.join(data_dir, "EMPTY.csv"), "w").write("timestamp,open,high,low,close,volume\n")
+    open(os.path.join(data_dir, "notes.txt"), "w").write("ignored\n")
+    store = PriceStore()
+    return store, store.load_directory(data_dir)
+
+def test_load_directory():
+    store, loaded = make_store()
+    assert loaded == ["AAA", "BBB"] and store.symbols() == ["AAA", "BBB"]
+
+    aaa = store.get("aaa") # symbols are case-insensitive
+    assert np.array_equal(aaa.timestamps, DAYS.astype("datetime64[s]")) # sorted oldest first
+    assert np.array_equal(aaa.columns["close"], CLOSE) and np.array_equal(aaa.columns["high"], CLOSE + 1.0)
+
+    # a .prices file wins over a CSV of the same symbol, and its columns are views of the mapping
+    bbb = store.get("BBB")
+    assert np.array_equal(bbb.columns["close"], CLOSE * 2.0)
+    assert not bbb.columns["close"].flags.owndata
+
+    assert len(aaa.select("close", "2024-01-05", "2024-01-10")) == 6 # a bare end date includes that day
+    assert np.shares_memory(aaa.select("close", "2024-01-05"), aaa.columns["close"])
+    try:
+        store.get("EMPTY")
+        assert False, "empty files are not loaded"
+    except KeyError:
+        pass
+
+def test_reload_keeps_other_symbols():
+    store, _ = make_store()
+    other_dir = tempfile.mkdtemp()
+    write_csv(os.path.join(other_dir, "CCC.csv"), DAYS[:5], CLOSE[:5])
+    assert store.load_directory(other_dir) == ["CCC"]
+    assert store.symbols() == ["AAA", "BBB", "CCC"]
+
+def test_append():
+    store, _ = make_store()
+    before = store.get("AAA")
+    days = DAYS[-1] + np.arange(1, 4).astype("timedelta64[D]")
+    bars = {name: [1.0, 2.0, 3.0] for name in PRICE_FILE_FIELDS}
+    after = store.append("AAA", days, bars)
+
+    assert store.get("AAA") is after and len(after) == len(before) + 3
+    assert np.array_equal(after.columns["close"], np.concatenate([CLOSE, [1.0, 2.0, 3.0]]))
+    assert after.timestamps[-1] == days[-1].astype("datetime64[s]")
+    assert after.lineage is before.lineage
+    assert len(before) == 40 and np.array_equal(before.columns["close"], CLOSE) # snapshots are unchanged
+
+    # appending again grows the same storage; appending to a stale snapshot branches off a copy
+    again = after.appended(days[-1:] + np.timedelta64(1, "D"), {name: [4.0] for name in PRICE_FILE_FIELDS})
+    branch = after.appended(days[-1:] + np.timedelta64(2, "D"), {name: [5.0] for name in PRICE_FILE_FIELDS})
+    assert again.lineage is after.lineage and branch.lineage is not after.lineage
+    assert again.columns["close"][-1] == 4.0 and branch.columns["close"][-1] == 5.0
+    assert len(after) == 43
+
+def test_append_rejects_bad_bars():
+    store, _ = make_store()
+    last = store.get("AAA").timestamps[-1]
+    fields = {name: [1.0] for name in PRICE_FILE_FIELDS}
+    bad = [
+        ([last], fields), # not after the last bar
+        ([last + np.timedelta64(1, "D")], {"close": [1.0]}), # missing fields
+        ([last + np.timedelta64(1, "D")], {name: [1.0, 2.0] for name in PRICE_FILE_FIELDS}), # length mismatch
+        ([last + np.timedelta64(2, "D"), last + np.timedelta64(1, "D")], {name: [1.0, 2.0] for name in PRICE_FILE_FIELDS}),
+    ]
+    for timestamps, columns in bad:
+        try:
+            store.append("AAA", timestamps, columns)
+            assert False, "expected ValueError"
+        except ValueError:
+            pass
+    assert len(store.get("AAA")) == 40
+    try:
+        store.append("ZZZ", [last], fields)
+        assert False, "expected KeyError"
+    except KeyError:
+        pass
+
+if __name__ == "__main__":
+    for test in (test_load_directory, test_reload_keeps_other_symbols, test_append, test_append_rejects_bad_bars):
+        test()
+        print(f"✅ {test.__name__} passed")
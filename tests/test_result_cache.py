@@ -0,0 +1,121 @@
+import os
+import sys
+import numpy as np
+
+# backend modules import each other by module name, as when the app runs from backend/
+sys.path.append(os.path.abspath(os.path.join(os.path.dirname(__file__), '..', 'backend')))
+
+from result_cache import ResultCache
+from wrapper import compute_SMA, hash_series
+
+class Counter:
+    # compute callback that records how often the cache had to run it
+    def __init__(self, result):
+        self.result = result
+        self.calls = 0
+
+    def __call__(self):
+        self.calls += 1
+        return [self.result.copy()]
+
+def test_hit_and_miss():
+    cache = ResultCache(8, 1 << 20)
+    prices = np.linspace(100.0, 110.0, 50)
+    key = ("compute_SMA", hash_series(prices), (5,))
+    compute = Counter(compute_SMA(prices, 5))
+
+    first = cache.get_or_compute(key, [prices], compute)
+    second = cache.get_or_compute(key, [prices.copy()], compute) # equal values in another buffer
+    assert compute.calls == 1 and second is first
+    assert not first[0].flags.writeable # every hit returns the same arrays
+    assert cache.stats()["hits"] == 1 and cache.stats()["misses"] == 1
+
+    cache.get_or_compute(("compute_SMA", hash_series(prices), (6,)), [prices], compute)
+    assert compute.calls == 2 and cache.stats()["entries"] == 2
+
+def test_hit_requires_bitwise_equal_inputs():
+    # the key only locates an entry; inputs that differ in any bit are a miss even under the same key,
+    # as after a hash collision
+    cache = ResultCache(8, 1 << 20)
+    key = ("compute_SMA", 0, (3,))
+    zeros = np.zeros(10)
+    compute = Counter(np.ones(8))
+    cache.get_or_compute(key, [zeros], compute)
+
+    variants = [np.full(10, -0.0), np.concatenate([zeros[:9], [5e-324]]), zeros[:9], np.zeros(11)]
+    for inputs in variants:
+        cache.get_or_compute(key, [inputs], compute)
+        cache.get_or_compute(key, [zeros], compute)
+    assert compute.calls == 1 + 2 * len(variants) # each variant replaced the entry, then zeros did again
+
+    nan = np.full(4, np.nan)
+    cache.get_or_compute(("nan", 0, ()), [nan], compute)
+    cache.get_or_compute(("nan", 0, ()), [nan.copy()], compute) # same NaN payload
+    assert compute.calls == 2 + 2 * len(variants)
+
+    # None (absent volumes) only matches None
+    cache.get_or_compute(("obv", 0, ()), [zeros, None], compute)
+    cache.get_or_compute(("obv", 0, ()), [zeros, zeros], compute)
+    cache.get_or_compute(("obv", 0, ()), [zeros, zeros], compute)
+    assert compute.calls == 4 + 2 * len(variants)
+
+def test_inputs_are_copied():
+    cache = ResultCache(8, 1 << 20)
+    prices = np.arange(10, dtype=np.double)
+    compute = Counter(np.ones(3))
+    cache.get_or_compute("key", [prices], compute)
+    prices[0] = 42.0 # the caller reuses its buffer
+    cache.get_or_compute("key", [prices], compute)
+    assert compute.calls == 2
+
+def test_eviction_by_entries():
+    cache = ResultCache(2, 1 << 20)
+    inputs = [np.zeros(4)]
+    compute = Counter(np.ones(4))
+    cache.get_or_compute("a", inputs, compute)
+    cache.get_or_compute("b", inputs, compute)
+    cache.get_or_compute("a", inputs, compute) # "b" is now the least recently used
+    cache.get_or_compute("c", inputs, compute)
+    assert cache.stats()["evictions"] == 1 and cache.stats()["entries"] == 2
+    calls = compute.calls
+    cache.get_or_compute("a", inputs, compute)
+    cache.get_or_compute("c", inputs, compute)
+    assert compute.calls == calls
+    cache.get_or_compute("b", inputs, compute)
+    assert compute.calls == calls + 1
+
+def test_eviction_by_bytes():
+    entry_bytes = 2 * 100 * 8 # 100 input and 100 result values
+    cache = ResultCache(100, 3 * entry_bytes)
+    inputs = [np.zeros(100)]
+    compute = Counter(np.ones(100))
+    for key in range(5):
+        cache.get_or_compute(key, inputs, compute)
+    stats = cache.stats()
+    assert stats["entries"] == 3 and stats["bytes"] == 3 * entry_bytes and stats["evictions"] == 2
+
+    # results larger than the whole budget are returned but never stored
+    large = Counter(np.ones(1000))
+    assert len(cache.get_or_compute("large", inputs, large)[0]) == 1000
+    cache.get_or_compute("large", inputs, large)
+    assert large.calls == 2 and cache.stats()["entries"] == 3
+
+def test_disabled_and_clear():
+    disabled = ResultCache(0, 1 << 20)
+    compute = Counter(np.ones(2))
+    disabled.get_or_compute("a", [np.zeros(2)], compute)
+    disabled.get_or_compute("a", [np.zeros(2)], compute)
+    assert compute.calls == 2 and disabled.stats()["entries"] == 0
+
+    cache = ResultCache(8, 1 << 20)
+    cache.get_or_compute("a", [np.zeros(2)], compute)
+    cache.clear()
+    assert cache.stats()["entries"] == 0 and cache.stats()["bytes"] == 0
+    cache.get_or_compute("a", [np.zeros(2)], compute)
+    assert compute.calls == 4
+
+if __name__ == "__main__":
+    for test in (test_hit_and_miss, test_hit_requires_bitwise_equal_inputs, test_inputs_are_copied,
+                 test_eviction_by_entries, test_eviction_by_bytes, test_disabled_and_clear):
+        test()
+        print(f"✅ {test.__name__} passed")
@@ -0,0 +1,52 @@
+import os
+import sys
+import numpy as np
+
+# backend modules import each other by module name, as when the app runs from backend/
+sys.path.append(os.path.abspath(os.path.join(os.path.dirname(__file__), '..', 'backend')))
+
+from wrapper import ffi, _as_doubles, _ptr, compute_SMA, compute_bollinger_bands, compute_MACD, compute_OBV
+
+def address(arr):
+    return int(ffi.cast("uintptr_t", _ptr(arr)))
+
+def test_contiguous_doubles_are_not_copied():
+    prices = np.linspace(100.0, 120.0, 64)
+    assert _as_doubles(prices) is prices
+    assert address(prices) == prices.ctypes.data
+
+    # a contiguous slice is passed as a pointer into its base array
+    window = prices[8:40]
+    assert _as_doubles(window) is window
+    assert address(window) == prices.ctypes.data + 8 * prices.itemsize
+
+def test_other_inputs_are_converted_once():
+    prices = np.arange(64, dtype=np.double)
+    for values in (prices.tolist(), prices.astype(np.float32), prices[::2], np.arange(64)):
+        converted = _as_doubles(values)
+        assert converted.dtype == np.double and converted.flags.c_contiguous
+        assert converted is not values
+        assert np.array_equal(converted, np.asarray(values, dtype=np.double))
+
+def test_results_match_across_input_types():
+    prices = 100.0 + 10.0 * np.sin(np.arange(300) * 0.05)
+    volumes = 1000.0 + np.arange(300) % 7
+    assert np.array_equal(compute_SMA(prices, 20), compute_SMA(prices.tolist(), 20))
+    assert np.array_equal(compute_SMA(prices[50:250], 20), compute_SMA(prices[50:250].copy(), 20))
+    assert np.array_equal(compute_SMA(prices[::2], 20), compute_SMA(prices[::2].copy(), 20))
+    assert np.array_equal(compute_OBV(prices, volumes), compute_OBV(prices.tolist(), volumes.tolist()))
+
+def test_multi_line_results_are_views_of_one_buffer():
+    # the C functions write each line straight into a row of one (3, n) array; the result is its transpose
+    prices = 100.0 + 10.0 * np.sin(np.arange(300) * 0.05)
+    for result in (compute_bollinger_bands(prices, 20, 2.0), compute_MACD(prices)):
+        assert result.ndim == 2 and result.shape[1] == 3
+        assert not result.flags.owndata and result.base.shape == (3, result.shape[0])
+    bands = compute_bollinger_bands(prices, 20, 2.0)
+    assert np.all(bands[:, 0] <= bands[:, 1]) and np.all(bands[:, 1] <= bands[:, 2])
+
+if __name__ == "__main__":
+    for test in (test_contiguous_doubles_are_not_copied, test_other_inputs_are_converted_once,
+                 test_results_match_across_input_types, test_multi_line_results_are_views_of_one_buffer):
+        test()
+        print(f"✅ {test.__name__} passed")